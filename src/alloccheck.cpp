@@ -0,0 +1,101 @@
+/**
+ * This programm calculates the variance/OC and/or the sensitivity of a set of
+ * pattern with the same weight. It is possible to improve your patternset and
+ * read patterns from a file.
+ *
+ * allocation check file; built and run by 'make check'
+ *
+ * For theory please have a look at and also cite, if you have used rasbhari in your publications:
+ *
+ * - Hahn L, Leimeister C-A, Ounit R, Lonardi S, Morgenstern B (2016)
+ * rasbhari: Optimizing Spaced Seeds for Database Searching, Read Mapping and Alignment-Free Sequence Comparison.
+ * PLoS Comput Biol 12(10):e1005107. doi:10.1371/journal.pcbi.1005107
+ *
+ * - B. Morgenstern, B. Zhu, S. Horwege, C.-A Leimeister (2015)
+ * Estimating evolutionary distances between genomic sequences from spaced-word matches
+ * Algorithms for Molecular Biology 10, 5. (http://www.almob.org/content/10/1/5/abstract)
+ *
+ *
+ * @author: Lars Hahn - 23.08.2017, Georg-August-Universitaet Goettingen
+ */
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include "rasbhari.hpp"
+
+namespace{
+    /**
+     * Number of hill climbing steps, that may allocate the thread local
+     * buffers, before the allocations are counted.
+     */
+    const unsigned WarmupSteps = 3000;
+
+    /**
+     * Number of hill climbing steps, that must not allocate.
+     */
+    const unsigned CheckSteps = 20000;
+
+    std::atomic<unsigned long> Allocations(0);
+}
+
+void * operator new(size_t Size){
+    Allocations.fetch_add(1, std::memory_order_relaxed);
+    void * Ptr = std::malloc(Size ? Size : 1);
+    if(!Ptr){
+        throw std::bad_alloc();
+    }
+    return Ptr;
+}
+void * operator new[](size_t Size){
+    return operator new(Size);
+}
+void operator delete(void * Ptr) noexcept{
+    std::free(Ptr);
+}
+void operator delete[](void * Ptr) noexcept{
+    std::free(Ptr);
+}
+void operator delete(void * Ptr, size_t) noexcept{
+    std::free(Ptr);
+}
+void operator delete[](void * Ptr, size_t) noexcept{
+    std::free(Ptr);
+}
+
+/**
+ * Runs the hill climbing of the climb and steepest engines for the variance
+ * and the OC; after a warm-up, the optimising steps must not allocate memory.
+ *
+ * @return              0, if no step allocated; otherwise the number of
+ *                          failed combinations.
+ */
+int main(){
+    const char * Engines[] = {"climb", "steepest"};
+    const char * Objectives[] = {"variance", "oc"};
+    int Failed = 0;
+    rasb_opt::Silent = true;
+    rasb_opt::Sens = false;
+    rasb_opt::Size = 12;
+    rasb_opt::Weight = 8;
+    rasb_opt::MinDontcare = 6;
+    rasb_opt::MaxDontcare = 20;
+    for(const char * Engine : Engines){
+        for(const char * Objective : Objectives){
+            rasb_opt::Engine = Engine;
+            rasb_opt::set_objective(Objective);
+            rasbhari RasbSet(rasb_opt::Size, rasb_opt::Weight, rasb_opt::MinDontcare, rasb_opt::MaxDontcare);
+            RasbSet.hill_climbing(WarmupSteps);
+            unsigned long Before = Allocations.load();
+            RasbSet.hill_climbing(CheckSteps);
+            unsigned long Count = Allocations.load() - Before;
+            std::cout << Engine << " " << Objective << ": " << Count << " allocations in " << CheckSteps << " steps";
+            if(Count != 0){
+                std::cout << " - FAILED";
+                Failed++;
+            }
+            std::cout << std::endl;
+        }
+    }
+    return Failed;
+}
@@ -0,0 +1,305 @@
+/**
+ * This programm calculates the variance/OC and/or the sensitivity of a set of
+ * pattern with the same weight. It is possible to improve your patternset and
+ * read patterns from a file.
+ *
+ * coefficient matrix object header file
+ *
+ * For theory please have a look at and also cite, if you have used rasbhari in your publications:
+ *
+ * - Hahn L, Leimeister C-A, Ounit R, Lonardi S, Morgenstern B (2016)
+ * rasbhari: Optimizing Spaced Seeds for Database Searching, Read Mapping and Alignment-Free Sequence Comparison.
+ * PLoS Comput Biol 12(10):e1005107. doi:10.1371/journal.pcbi.1005107
+ *
+ * - B. Morgenstern, B. Zhu, S. Horwege, C.-A Leimeister (2015)
+ * Estimating evolutionary distances between genomic sequences from spaced-word matches
+ * Algorithms for Molecular Biology 10, 5. (http://www.almob.org/content/10/1/5/abstract)
+ *
+ *
+ * @author: Lars Hahn - 23.08.2017, Georg-August-Universitaet Goettingen
+ */
+#ifndef COEFMATRIX_HPP_
+#define COEFMATRIX_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * An object/instance of the coefficient matrix class holds the symmetric
+ * matrix of the pair coefficients of a pattern set. Only the upper triangle
+ * is stored, packed column by column into one aligned buffer, such that the
+ * coefficients (i,j), i <= j, of a column j are contiguous. The buffer also
+ * holds the row sums, i.e. the contributions of the patterns to the score;
+ * set() keeps them up to date. A copy of the matrix is a single memcpy.
+ */
+template<typename T>
+class coefmatrix{
+    static_assert(std::is_trivially_copyable<T>::value, "coefmatrix needs a trivially copyable coefficient type");
+    public:
+        coefmatrix();
+        coefmatrix(unsigned Size);
+        coefmatrix(const coefmatrix & Mat);
+        coefmatrix(coefmatrix && Mat);
+        coefmatrix & operator=(const coefmatrix & Mat);
+        coefmatrix & operator=(coefmatrix && Mat);
+
+        T get(unsigned Idx1, unsigned Idx2) const;
+        void set(unsigned Idx1, unsigned Idx2, T Coef);
+        void assign(unsigned Idx1, unsigned Idx2, T Coef);
+        T & row_sum(unsigned Idx);
+        T row_sum(unsigned Idx) const;
+        void sum_rows();
+        T sum() const;
+        void clear();
+        void reset(unsigned Size);
+        unsigned size() const;
+
+    private:
+        static const size_t Align = 64;
+        size_t _index(unsigned Idx1, unsigned Idx2) const;
+        void _allocate(unsigned Size);
+
+        std::unique_ptr<char[]> _Buffer;
+        size_t _Bytes;
+        T * _Coefs;
+        T * _RowSums;
+        unsigned _Size;
+};
+
+/**
+ * The empty-constructor; creates an empty matrix.
+ */
+template<typename T>
+coefmatrix<T>::coefmatrix(): _Bytes(0), _Coefs(nullptr), _RowSums(nullptr), _Size(0){
+}
+/**
+ * The default-constructor; creates a matrix of zeros for Size patterns.
+ *
+ * @param Size          The number of patterns.
+ */
+template<typename T>
+coefmatrix<T>::coefmatrix(unsigned Size): coefmatrix(){
+    _allocate(Size);
+    memset(_Coefs, 0, _Bytes);
+}
+/**
+ * The copy-constructor.
+ *
+ * @param Mat           The matrix to be copied.
+ */
+template<typename T>
+coefmatrix<T>::coefmatrix(const coefmatrix & Mat): coefmatrix(){
+    *this = Mat;
+}
+/**
+ * The move-constructor; takes over the buffer of the other matrix.
+ *
+ * @param Mat           The matrix to be moved, it is empty afterwards.
+ */
+template<typename T>
+coefmatrix<T>::coefmatrix(coefmatrix && Mat): coefmatrix(){
+    *this = std::move(Mat);
+}
+/**
+ * The copy-assignment; the buffer is reused, if the sizes match.
+ *
+ * @param Mat           The matrix to be copied.
+ *
+ * @return              This matrix.
+ */
+template<typename T>
+coefmatrix<T> & coefmatrix<T>::operator=(const coefmatrix & Mat){
+    if(this != &Mat){
+        if(_Size != Mat._Size || !_Buffer){
+            _allocate(Mat._Size);
+        }
+        if(_Bytes != 0){
+            memcpy(_Coefs, Mat._Coefs, _Bytes);
+        }
+    }
+    return *this;
+}
+/**
+ * The move-assignment; takes over the buffer of the other matrix.
+ *
+ * @param Mat           The matrix to be moved, it is empty afterwards.
+ *
+ * @return              This matrix.
+ */
+template<typename T>
+coefmatrix<T> & coefmatrix<T>::operator=(coefmatrix && Mat){
+    if(this != &Mat){
+        _Buffer = std::move(Mat._Buffer);
+        _Bytes = Mat._Bytes;
+        _Coefs = Mat._Coefs;
+        _RowSums = Mat._RowSums;
+        _Size = Mat._Size;
+        Mat.clear();
+    }
+    return *this;
+}
+
+/**
+ * Returns a coefficient; the matrix is symmetric.
+ *
+ * @param Idx1          The index of the first pattern.
+ *
+ * @param Idx2          The index of the second pattern.
+ *
+ * @return              The pair coefficient.
+ */
+template<typename T>
+inline T coefmatrix<T>::get(unsigned Idx1, unsigned Idx2) const{
+    return _Coefs[_index(Idx1, Idx2)];
+}
+/**
+ * Sets a coefficient and updates the row sums of both patterns.
+ *
+ * @param Idx1          The index of the first pattern.
+ *
+ * @param Idx2          The index of the second pattern.
+ *
+ * @param Coef          The new pair coefficient.
+ */
+template<typename T>
+inline void coefmatrix<T>::set(unsigned Idx1, unsigned Idx2, T Coef){
+    T & Entry = _Coefs[_index(Idx1, Idx2)];
+    _RowSums[Idx1] -= Entry;
+    _RowSums[Idx1] += Coef;
+    if(Idx1 != Idx2){
+        _RowSums[Idx2] -= Entry;
+        _RowSums[Idx2] += Coef;
+    }
+    Entry = Coef;
+}
+/**
+ * Sets a coefficient without changing the row sums; used for the initial
+ * computation by several threads, afterwards sum_rows() has to be called.
+ *
+ * @param Idx1          The index of the first pattern.
+ *
+ * @param Idx2          The index of the second pattern.
+ *
+ * @param Coef          The new pair coefficient.
+ */
+template<typename T>
+inline void coefmatrix<T>::assign(unsigned Idx1, unsigned Idx2, T Coef){
+    _Coefs[_index(Idx1, Idx2)] = Coef;
+}
+/**
+ * Returns the row sum of a pattern, i.e. the sum of all its coefficients.
+ *
+ * @param Idx           The index of the pattern.
+ *
+ * @return              The row sum; r-value
+ */
+template<typename T>
+inline T & coefmatrix<T>::row_sum(unsigned Idx){
+    return _RowSums[Idx];
+}
+/**
+ * Returns the row sum of a pattern, i.e. the sum of all its coefficients.
+ *
+ * @param Idx           The index of the pattern.
+ *
+ * @return              The row sum; constant
+ */
+template<typename T>
+inline T coefmatrix<T>::row_sum(unsigned Idx) const{
+    return _RowSums[Idx];
+}
+/**
+ * Recomputes all row sums from the coefficients.
+ */
+template<typename T>
+void coefmatrix<T>::sum_rows(){
+    for(unsigned i = 0; i < _Size; i++){
+        _RowSums[i] = 0;
+    }
+    for(unsigned j = 0; j < _Size; j++){
+        const T * Column = &_Coefs[_index(0, j)];
+        for(unsigned i = 0; i < j; i++){
+            _RowSums[i] += Column[i];
+            _RowSums[j] += Column[i];
+        }
+        _RowSums[j] += Column[j];
+    }
+}
+/**
+ * Returns the sum of the upper triangle, i.e. the score of the set.
+ *
+ * @return              The sum of all coefficients (i,j), i <= j.
+ */
+template<typename T>
+T coefmatrix<T>::sum() const{
+    T Sum = 0;
+    size_t Entries = (size_t)_Size*(_Size+1)/2;
+    for(size_t k = 0; k < Entries; k++){
+        Sum += _Coefs[k];
+    }
+    return Sum;
+}
+/**
+ * Frees the matrix.
+ */
+template<typename T>
+void coefmatrix<T>::clear(){
+    _Buffer.reset();
+    _Bytes = 0;
+    _Coefs = nullptr;
+    _RowSums = nullptr;
+    _Size = 0;
+}
+/**
+ * Sets the matrix to zeros for Size patterns; the buffer is reused, if the
+ * size does not change.
+ *
+ * @param Size          The number of patterns.
+ */
+template<typename T>
+void coefmatrix<T>::reset(unsigned Size){
+    if(_Size != Size || !_Buffer){
+        _allocate(Size);
+    }
+    memset(_Coefs, 0, _Bytes);
+}
+/**
+ * Returns the number of patterns.
+ *
+ * @return              The number of rows and columns.
+ */
+template<typename T>
+unsigned coefmatrix<T>::size() const{
+    return _Size;
+}
+
+/**
+ * Returns the position of a coefficient in the packed upper triangle.
+ */
+template<typename T>
+inline size_t coefmatrix<T>::_index(unsigned Idx1, unsigned Idx2) const{
+    if(Idx1 > Idx2){
+        std::swap(Idx1, Idx2);
+    }
+    return (size_t)Idx2*(Idx2+1)/2 + Idx1;
+}
+/**
+ * Allocates the aligned buffer for the triangle and the row sums.
+ *
+ * @param Size          The number of patterns.
+ */
+template<typename T>
+void coefmatrix<T>::_allocate(unsigned Size){
+    size_t RowOffset = ((size_t)Size*(Size+1)/2*sizeof(T) + Align-1) / Align * Align;
+    _Size = Size;
+    _Bytes = RowOffset + Size*sizeof(T);
+    _Buffer.reset(new char[_Bytes + Align]);
+    uintptr_t Address = reinterpret_cast<uintptr_t>(_Buffer.get());
+    _Coefs = reinterpret_cast<T*>((Address + Align-1) / Align * Align);
+    _RowSums = reinterpret_cast<T*>(reinterpret_cast<char*>(_Coefs) + RowOffset);
+}
+
+#endif
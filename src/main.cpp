@@ -19,13 +19,14 @@
  * @author: Lars Hahn - 23.08.2017, Georg-August-Universität Goettingen
  * @version: 1.4.0 08/2017
  */
+#include <algorithm>
 #include <iostream>
 
 #include "rasbhari.hpp"
 #include "rasbopt.hpp"
 #include "rasbimp.hpp"
 
-void SecurityMessage(std::string errmsg, char* argv[], int pos);
+void SecurityMessage(std::string errmsg, char* argv[], int pos, unsigned line = 0);
 
 int main(int argc, char *argv[]){
     rasb_opt::Quiet = true;
@@ -34,6 +35,7 @@ int main(int argc, char *argv[]){
     rasb_opt::OutFile = "";
     double TmpDb;
     bool LengSet = false;
+    int PatternArg = 0;
 
     bool Exit = false;
     std::string tmp;
@@ -116,15 +118,61 @@ int main(int argc, char *argv[]){
             break;
         case '-':
             parse = argv[i];
-            if(parse == "--forcesens"){
+            if(parse == "--cooling"){
+                if (i < argc - 1) {
+                    rasb_opt::Cooling = argv[i + 1];
+                    i++;
+                    if(rasb_opt::Cooling != "geometric" && rasb_opt::Cooling != "linear"){
+                        SecurityMessage("parsing", argv, i);
+                        rasb_opt::Cooling = "geometric";
+                    }
+                }
+            }
+            else if(parse == "--elite"){
+                if (i < argc - 1) {
+                    rasb_opt::Elite = atoi(argv[i + 1]);
+                    i++;
+                    if(rasb_opt::Elite == 1){
+                        rasb_opt::Elite = 2;
+                    }
+                }
+            }
+            else if(parse == "--engine"){
+                if (i < argc - 1) {
+                    rasb_opt::Engine = argv[i + 1];
+                    i++;
+                    if(rasb_opt::Engine != "climb" && rasb_opt::Engine != "steepest" && rasb_opt::Engine != "anneal" && rasb_opt::Engine != "temper" && rasb_opt::Engine != "tabu"){
+                        SecurityMessage("parsing", argv, i);
+                        rasb_opt::Engine = "climb";
+                    }
+                }
+            }
+            else if(parse == "--forcesens"){
                 rasb_opt::Forcesens = true;
             }
+            else if(parse == "--histogram") {
+                if (i < argc - 1) {
+                    rasb_opt::HistFile = argv[i + 1];
+                    i++;
+                }
+            }
             else if(parse == "--nosens"){
                 rasb_opt::Sens = false;
             }
             else if(parse == "--notquiet") {
                 rasb_opt::Quiet = false;
             }
+            else if(parse == "--objective"){
+                if (i < argc - 1) {
+                    i++;
+                    if(rasbhari::is_objective(argv[i])){
+                        rasb_opt::set_objective(argv[i]);
+                    }
+                    else{
+                        SecurityMessage("parsing", argv, i);
+                    }
+                }
+            }
             else if(parse == "--opt-oc"){
                 if (i < argc - 1) {
                     rasb_opt::OptOc = atoi(argv[i + 1]);
@@ -152,6 +200,7 @@ int main(int argc, char *argv[]){
             else if(parse == "--pattern") {
                 if (i < argc - 1) {
                     rasb_opt::InFile = argv[i + 1];
+                    PatternArg = i + 1;
                     i++;
                 }
             }
@@ -161,11 +210,54 @@ int main(int argc, char *argv[]){
                     i++;
                 }
             }
+            else if(parse == "--reheat"){
+                if (i < argc - 1) {
+                    rasb_opt::Reheat = atoi(argv[i + 1]);
+                    i++;
+                }
+            }
+            else if(parse == "--rescore") {
+                if (i < argc - 1) {
+                    rasb_opt::RescoreFile = argv[i + 1];
+                    i++;
+                }
+            }
+            else if(parse == "--seed"){
+                if (i < argc - 1) {
+                    rasb_opt::Seed = atol(argv[i + 1]);
+                    rasb_opt::SetSeed = true;
+                    i++;
+                }
+            }
             else if(parse == "--silent"){
                 rasb_opt::Silent = true;
             }
+            else if(parse == "--temp"){
+                if (i < argc - 1) {
+                    TmpDb = atof(argv[i + 1]);
+                    i++;
+                    if(0 < TmpDb && TmpDb < 1){
+                        rasb_opt::Temp = TmpDb;
+                    }
+                    else{
+                        SecurityMessage("parsing", argv, i);
+                    }
+                }
+            }
+            else if(parse == "--tenure"){
+                if (i < argc - 1) {
+                    rasb_opt::Tenure = atoi(argv[i + 1]);
+                    i++;
+                }
+            }
+            else if(parse == "--threads"){
+                if (i < argc - 1) {
+                    rasb_opt::Threads = atoi(argv[i + 1]);
+                    i++;
+                }
+            }
             else if(parse == "--variance") {
-                rasb_opt::Oc = false;
+                rasb_opt::set_objective("variance");
             }
             else {
                 SecurityMessage("parsing", argv, i);
@@ -178,7 +270,7 @@ int main(int argc, char *argv[]){
     }
 
     if(LengSet == false){
-        if(rasb_opt::Oc){
+        if(rasbhari::overlap_objective(rasb_opt::Objective)){
             rasb_opt::MinDontcare = rasb_opt::Weight+3;
             rasb_opt::MaxDontcare = 2*(rasb_opt::Weight+3);
         }
@@ -187,6 +279,24 @@ int main(int argc, char *argv[]){
         }
     }
 
+    if(rasb_opt::InFile.size() != 0){
+        unsigned Line = patternset::long_pattern_line(rasb_opt::InFile);
+        if(Line != 0){
+            SecurityMessage("length", argv, PatternArg, Line);
+            return -1;
+        }
+    }
+
+    if(rasb_opt::RescoreFile.size() != 0){
+        rasb_implement::rescore();
+        return 0;
+    }
+
+    if(rasb_opt::InFile.size() == 0 && rasb_opt::Weight + std::max(rasb_opt::MinDontcare, rasb_opt::MaxDontcare) > pattern::MaxLength){
+        SecurityMessage("length", argv, 0);
+        return -1;
+    }
+
     std::cout << "\n====================================" << std::endl;
     std::cout << "Parameter for variance calculation:" << std::endl;
     std::cout << "====================================\n" << std::endl;
@@ -197,13 +307,7 @@ int main(int argc, char *argv[]){
     std::cout << "Pattern don't care          = " << rasb_opt::MinDontcare << " - " << rasb_opt::MaxDontcare << std::endl;
     std::cout << "Pattern weight              = " << rasb_opt::Weight << std::endl;
     std::cout << "Patternset                  = " << rasb_opt::Size << " Pattern" << std::endl;
-    std::cout << "Calculation type            :";
-    if(rasb_opt::Oc){
-        std::cout << " Overlap complexity\n\n" << std::endl;
-    }
-    else{
-        std::cout << " Variance\n\n" << std::endl;
-    }
+    std::cout << "Calculation type            : " << rasbhari::objective_label(rasb_opt::Objective) << "\n\n" << std::endl;
 
     std::cout << "Hillclimbing ?";
     if(rasb_opt::Limit > 0){
@@ -232,31 +336,19 @@ int main(int argc, char *argv[]){
 
     if(rasb_opt::Sens == false){
         if(rasb_opt::OptOc == 1){
-            if(rasb_opt::Oc){
-                RasbSet = rasb_implement::hillclimb_oc();
-            }
-            else{
-                RasbSet = rasb_implement::hillclimb_var();
-            }
+            RasbSet = rasb_implement::hillclimb();
         }
         else{
-            if(rasb_opt::Oc){
-                RasbSet = rasb_implement::hillclimb_oc_iterative();
-            }
-            else{
-                RasbSet = rasb_implement::hillclimb_var_iterative();
-            }
+            RasbSet = rasb_implement::hillclimb_iterative();
         }
     }
     else{
-        if(rasb_opt::Oc){
-            RasbSet = rasb_implement::hillclimb_sens_oc();
-        }
-        else{
-            RasbSet = rasb_implement::hillclimb_sens_var();
-        }
+        RasbSet = rasb_implement::hillclimb_sens();
     }
     RasbSet.to_file();
+    if(rasb_opt::HistFile.size() != 0){
+        overlaphist(RasbSet.pattern_set()).to_file(rasb_opt::HistFile);
+    }
 }
 
 /**
@@ -268,8 +360,11 @@ int main(int argc, char *argv[]){
  * @param argv          Pointer to an array of char arrays, for the arg-list.
  *
  * @param pos           Integer indicating which parameter is wrong.
+ *
+ * @param line          Line of the file given by argv[pos], that holds a too
+ *                          long pattern; 0 if the length is not from a file.
  */
-void SecurityMessage(std::string errmsg, char* argv[], int pos){
+void SecurityMessage(std::string errmsg, char* argv[], int pos, unsigned line){
     if (errmsg == "param") {
         std::cerr << "This programm calculates the variance/OC and/or the sensitivity of a set of pattern with the same weight."<< std::endl;
         std::cerr << "It is possible to improve your patternset and read patterns from a file.\n" << std::endl;
@@ -279,13 +374,30 @@ void SecurityMessage(std::string errmsg, char* argv[], int pos){
         std::cerr << "\t\t --nosens: \t\t Deactivate the sensitivity calculation.\n" << std::endl;
         std::cerr << "\t\t --forcesens: \t\t Force the sensitivity calculation ON YOUR OWN RISK!\n" << std::endl;
         std::cerr << "\t\t --variance: \t\t Change calculation from overlap complexity to variance.\n" << std::endl;
+        std::cerr << "\t\t --objective [str]: \t Objective to optimise; 'oc' overlap complexity, 'variance' variance, 'woc' weighted overlap complexity with (1/p)^overlap per shift." << std::endl;
+        std::cerr << "\t\t\t\t\t\t default: objective = oc\n" << std::endl;
         std::cerr << "\t\t --opt-oc [int]: \t Creates [int] times new patternsets and tries to optimize them to best variance/oc; after modifying by '--permut [int]'." << std::endl;
         std::cerr << "\t\t\t\t\t\t default: opt-oc = 100\n" << std::endl;
         std::cerr << "\t\t --opt-sens [int]: \t Creates [int] times new patternsets and tries to optimize them to best sensitivity; after variance/oc optimization." << std::endl;
         std::cerr << "\t\t\t\t\t\t default: opt-sens = 5000\n" << std::endl;
+        std::cerr << "\t\t --elite [int]: \t Keeps the [int] best distinct patternsets of '--opt-oc'; if the pool is full, each further patternset is created by crossover of two sets of the pool, taking each pattern from one of them. 0 creates each patternset at random." << std::endl;
+        std::cerr << "\t\t\t\t\t\t default: elite = 0\n" << std::endl;
         std::cerr << "\t\t --notquiet: \t\t Show each step of the improving mode.\n" << std::endl;
+        std::cerr << "\t\t --engine [str]: \t Optimisation engine; 'climb' tries one random swap per step, 'steepest' scores all swaps of a pattern per step and stops in a local optimum, 'anneal' also accepts worse swaps with a probability, that shrinks with the temperature, 'temper' anneals one replica per thread at a fixed temperature from 0 up to the start temperature and swaps the temperatures of neighbouring replicas every 500 steps; the set at temperature 0 is taken, 'tabu' also accepts equal swaps, but does not change a position of a pattern again for '--tenure [int]' steps and does not score a set twice." << std::endl;
+        std::cerr << "\t\t\t\t\t\t default: engine = climb\n" << std::endl;
+        std::cerr << "\t\t --cooling [str]: \t Cooling schedule of 'anneal' over '--permut [int]' steps; 'geometric' multiplies the temperature by a constant factor down to 1/1000 of the start, 'linear' lowers it by a constant step down to 0." << std::endl;
+        std::cerr << "\t\t\t\t\t\t default: cooling = geometric\n" << std::endl;
+        std::cerr << "\t\t --temp [double]: \t Start temperature of 'anneal' and highest temperature of 'temper', given as the probability to accept an average worse swap; 0 < temp < 1." << std::endl;
+        std::cerr << "\t\t\t\t\t\t default: temp = 0.5\n" << std::endl;
+        std::cerr << "\t\t --reheat [int]: \t Restarts the cooling schedule of 'anneal', if no better set was found for [int] steps; 0 never restarts it." << std::endl;
+        std::cerr << "\t\t\t\t\t\t default: reheat = 0\n" << std::endl;
+        std::cerr << "\t\t --tenure [int]: \t Number of steps of 'tabu', for which the positions of an accepted swap can not be swapped back." << std::endl;
+        std::cerr << "\t\t\t\t\t\t default: tenure = 100\n" << std::endl;
         std::cerr << "\t\t --permut [int]: \t Selects [int] times a specific pattern and tries to modify it randomly by permutation." << std::endl;
         std::cerr << "\t\t\t\t\t\t default: permut = 25000\n" << std::endl;
+        std::cerr << "\t\t --seed [int]: \t\t Seeds the random stream of the optimisation, such that a run can be repeated; without, the seed is drawn from the random device.\n" << std::endl;
+        std::cerr << "\t\t --threads [int]: \t Runs the restarts of '--opt-oc' and the loops of '--opt-sens' on [int] threads, each with its own pattern set; the best set is taken. Sets of at least 64 patterns are scored on [int] threads. Without, everything runs on one thread. With '--engine temper' the number of replicas, at least 2." << std::endl;
+        std::cerr << "\t\t\t\t\t\t default: threads = 0\n" << std::endl;
         std::cerr << "\t=== Variance Parameters ===" << std::endl;
         std::cerr << "\t\t -S [int]: \t\t Sequence length of the dataset." << std::endl;
         std::cerr << "\t\t\t\t\t\t default: S = 10000\n" << std::endl;
@@ -302,11 +414,13 @@ void SecurityMessage(std::string errmsg, char* argv[], int pos){
         std::cerr << "\t\t    [int]-[int]: \t Min. and max. number of don't care positions, afterwards creating autopatternset." << std::endl;
         std::cerr << "\t\t\t\t\t\t default: d = (1/p)*weight \t\t\t{variance}" << std::endl;
         std::cerr << "\t\t\t\t\t\t default: d = [weight+3]-[2*(weight+3)] \t{OC}" << std::endl;
-        std::cerr << "\t\t\t\t\t\t patternlength = weight + don't care\n" << std::endl;
+        std::cerr << "\t\t\t\t\t\t patternlength = weight + don't care, at most 256\n" << std::endl;
         std::cerr << "\t\t -w [int]: \t\t Pattern weight, afterwards creating autopatternset." << std::endl;
         std::cerr << "\t\t\t\t\t\t default: w = 8\n" << std::endl;
-        std::cerr << "\t\t --pattern <File>: \t Reading pattern from <File> in pattern format with '0' and '1', seperated by ','|' '|'.'|';'|'\\n'|'\\t'.\n\n" << std::endl;
+        std::cerr << "\t\t --pattern <File>: \t Reading pattern from <File> in pattern format with '0' and '1', seperated by ','|' '|'.'|';'|'\\n'|'\\t'; at most 256 positions per pattern.\n\n" << std::endl;
         std::cerr << "\t\t --outfile <File>: \t Save the best pattern, its variance/oc and norm_variance/oc into <File>.\n" << std::endl;
+        std::cerr << "\t\t --histogram <File>: \t Save the overlap histograms of the best patternset into <File>; with '--rescore' and without '--pattern' the histograms are read from <File>.\n" << std::endl;
+        std::cerr << "\t\t --rescore <File>: \t Scores the patterns of '--pattern' or '--histogram' for each line 'p q S' of <File>, no optimisation is done.\n" << std::endl;
         std::cerr << "\t=== Additional Parameters ====" << std::endl;
         std::cerr << "\t\t --version: \t\t Print the program version.\n" << std::endl;
         std::cerr << "\t\t --help: \t\t Print this help.\n" << std::endl;
@@ -318,6 +432,17 @@ void SecurityMessage(std::string errmsg, char* argv[], int pos){
         std::cerr << " while parsing " << pos / 2 + 1 << ". argument, unknown option '" << argv[pos] << "'!\n" << std::endl;
         return;
     }
+    if (errmsg == "length") {
+        printf("%c[1;31mError", 27);
+        printf("%c[0m", 27);
+        if(line != 0){
+            std::cerr << " in line " << line << " of '" << argv[pos] << "', pattern exceeds the maximum pattern length of " << pattern::MaxLength << "!\n" << std::endl;
+            return;
+        }
+        std::cerr << " pattern length = weight + don't care = " << rasb_opt::Weight + std::max(rasb_opt::MinDontcare, rasb_opt::MaxDontcare);
+        std::cerr << " exceeds the maximum pattern length of " << pattern::MaxLength << "!\n" << std::endl;
+        return;
+    }
     if (errmsg == "version") {
         std::cout << "rasbhari, Version 1.4.0 - (c) 2017 Lars Hahn" << std::endl;
         std::cout << "This program is released under GPLv3." << std::endl << std::endl;
@@ -0,0 +1,228 @@
+/**
+ * This programm calculates the variance/OC and/or the sensitivity of a set of
+ * pattern with the same weight. It is possible to improve your patternset and
+ * read patterns from a file.
+ *
+ * overlap histogram object file
+ *
+ * For theory please have a look at and also cite, if you have used rasbhari in your publications:
+ *
+ * - Hahn L, Leimeister C-A, Ounit R, Lonardi S, Morgenstern B (2016)
+ * rasbhari: Optimizing Spaced Seeds for Database Searching, Read Mapping and Alignment-Free Sequence Comparison.
+ * PLoS Comput Biol 12(10):e1005107. doi:10.1371/journal.pcbi.1005107
+ *
+ * - B. Morgenstern, B. Zhu, S. Horwege, C.-A Leimeister (2015)
+ * Estimating evolutionary distances between genomic sequences from spaced-word matches
+ * Algorithms for Molecular Biology 10, 5. (http://www.almob.org/content/10/1/5/abstract)
+ *
+ *
+ * @author: Lars Hahn - 23.08.2017, Georg-August-Universitaet Goettingen
+ */
+#include "overlaphist.hpp"
+
+/**
+ * The empty-constructor; creates histograms for an empty set.
+ */
+overlaphist::overlaphist(): _Weight(0){
+}
+/**
+ * The patternset-constructor; counts for each pattern pair the overlaps of
+ * all shifts.
+ *
+ * @param Pattern       The pattern set.
+ */
+overlaphist::overlaphist(const patternset & Pattern): _Weight(Pattern.max_weight()){
+    std::vector<unsigned> Overlaps;
+    unsigned Size = Pattern.size();
+    _Lengths = std::vector<unsigned>(Size);
+    for(unsigned i = 0; i < Size; i++){
+        _Lengths[i] = Pattern[i].length();
+    }
+    _Counts = std::vector<uint32_t>((size_t)Size*(Size+1)/2*(_Weight+1), 0);
+    uint32_t * Counts = _Counts.data();
+    for(unsigned i = 0; i < Size; i++){
+        for(unsigned j = i; j < Size; j++){
+            Pattern[i].get_overlaps(Pattern[j], Overlaps);
+            unsigned Begin = i == j ? Pattern[i].length()-1 : 0;
+            for(unsigned s = Begin; s < Overlaps.size(); s++){
+                Counts[Overlaps[s]]++;
+            }
+            Counts += _Weight+1;
+        }
+    }
+}
+/**
+ * The file-constructor; reads histograms, that were written by to_file().
+ *
+ * @param HistFile      The name of the histogram file.
+ */
+overlaphist::overlaphist(std::string HistFile): _Weight(0){
+    std::ifstream Input(HistFile);
+    if(!Input.is_open()){
+        std::cerr << "Could not open histogram file '" << HistFile << "'!" << std::endl;
+        std::exit(-1);
+    }
+    unsigned Size = 0, Pairs = 0;
+    std::string Line;
+    while(std::getline(Input, Line)){
+        if(Line.empty() || Line[0] == '#'){
+            continue;
+        }
+        std::istringstream Fields(Line);
+        std::string Key;
+        Fields >> Key;
+        if(Key == "size"){
+            Fields >> Size;
+        }
+        else if(Key == "weight"){
+            Fields >> _Weight;
+        }
+        else if(Key == "lengths"){
+            unsigned Length;
+            while(Fields >> Length){
+                _Lengths.push_back(Length);
+            }
+        }
+        else{
+            uint32_t Count;
+            Fields.clear();
+            Fields.str(Line);
+            unsigned Idx1, Idx2;
+            Fields >> Idx1 >> Idx2;
+            while(Fields >> Count){
+                _Counts.push_back(Count);
+            }
+            Pairs++;
+        }
+    }
+    Input.close();
+    if(_Lengths.size() != Size || Pairs != (size_t)Size*(Size+1)/2 || _Counts.size() != (size_t)Pairs*(_Weight+1)){
+        std::cerr << "Illegal histogram file '" << HistFile << "'!" << std::endl;
+        std::exit(-1);
+    }
+}
+
+/**
+ * Returns the overlap complexity of the set, the sum over all pattern pairs
+ * i <= j of 2^Overlap for every shift. The sum is exact, if it is held by
+ * oc_int, otherwise it is summed with doubles.
+ *
+ * @return              The overlap complexity.
+ */
+double overlaphist::oc() const{
+    unsigned MaxLength = 0;
+    for(unsigned Length : _Lengths){
+        MaxLength = std::max(MaxLength, Length);
+    }
+    uint64_t Shifts = (uint64_t)size()*(size()+1)/2*(2*MaxLength);
+    if(rasbhari_compute::oc_exact(_Weight, Shifts)){
+        return (double)_oc<rasbhari_compute::oc_int>();
+    }
+    return _oc<double>();
+}
+/**
+ * Sums the overlap complexity in a passed number type.
+ *
+ * @return              The overlap complexity.
+ */
+template<typename Value>
+Value overlaphist::_oc() const{
+    Value Score = 0;
+    for(unsigned i = 0; i < size(); i++){
+        for(unsigned j = i; j < size(); j++){
+            const uint32_t * Counts = _counts(i,j);
+            Value Coef = 0, Power = 1, MaxPower = 1;
+            for(unsigned k = 0; k <= _Weight; k++, Power *= 2){
+                Coef += Counts[k]*Power;
+                if(Counts[k] != 0){
+                    MaxPower = Power;
+                }
+            }
+            if(i == j){
+                Coef = 2*Coef - MaxPower;
+            }
+            Score += Coef;
+        }
+    }
+    return Score;
+}
+/**
+ * Returns the variance of the set for the parameters of a variance table.
+ *
+ * @param Table         The variance table, bound to P, Q, S and the weight.
+ *
+ * @return              The variance of the set.
+ */
+double overlaphist::variance(const rasbhari_compute::var_table & Table) const{
+    double Score = 0;
+    for(unsigned i = 0; i < size(); i++){
+        for(unsigned j = i; j < size(); j++){
+            const uint32_t * Counts = _counts(i,j);
+            double FacP, FacQ;
+            Table.length_factors(_Lengths[i], _Lengths[j], FacP, FacQ);
+            for(unsigned k = 0; k <= _Weight; k++){
+                if(Counts[k] != 0){
+                    Score += Counts[k] * Table.term(k, FacP, FacQ);
+                }
+            }
+        }
+    }
+    return Score;
+}
+/**
+ * Writes the histograms into a file; each line holds the indices of a
+ * pattern pair and the counts for the overlaps 0 to weight.
+ *
+ * @param HistFile      The name of the histogram file.
+ */
+void overlaphist::to_file(std::string HistFile) const{
+    std::ofstream Output(HistFile);
+    if(!Output.is_open()){
+        std::cerr << "Could not write histogram file '" << HistFile << "'!" << std::endl;
+        std::exit(-1);
+    }
+    Output << "#rasbhari overlap histograms: pattern pair i j, number of shifts with overlap 0.." << _Weight << std::endl;
+    Output << "size " << size() << std::endl;
+    Output << "weight " << _Weight << std::endl;
+    Output << "lengths";
+    for(unsigned Length : _Lengths){
+        Output << " " << Length;
+    }
+    Output << std::endl;
+    for(unsigned i = 0; i < size(); i++){
+        for(unsigned j = i; j < size(); j++){
+            const uint32_t * Counts = _counts(i,j);
+            Output << i << " " << j;
+            for(unsigned k = 0; k <= _Weight; k++){
+                Output << " " << Counts[k];
+            }
+            Output << std::endl;
+        }
+    }
+    Output.close();
+}
+
+/**
+ * Returns the number of patterns.
+ *
+ * @return              The number of patterns of the set.
+ */
+unsigned overlaphist::size() const{
+    return _Lengths.size();
+}
+/**
+ * Returns the weight of the patterns, i.e. the maximal overlap.
+ *
+ * @return              The pattern weight.
+ */
+unsigned overlaphist::weight() const{
+    return _Weight;
+}
+/**
+ * Returns the counts of a pattern pair; the pairs i <= j are stored row by
+ * row.
+ */
+const uint32_t * overlaphist::_counts(unsigned Idx1, unsigned Idx2) const{
+    size_t Pair = (size_t)Idx1*size() - (size_t)Idx1*(Idx1-1)/2 + (Idx2-Idx1);
+    return &_Counts[Pair*(_Weight+1)];
+}
@@ -0,0 +1,68 @@
+/**
+ * This programm calculates the variance/OC and/or the sensitivity of a set of
+ * pattern with the same weight. It is possible to improve your patternset and
+ * read patterns from a file.
+ *
+ * overlap histogram object header file
+ *
+ * For theory please have a look at and also cite, if you have used rasbhari in your publications:
+ *
+ * - Hahn L, Leimeister C-A, Ounit R, Lonardi S, Morgenstern B (2016)
+ * rasbhari: Optimizing Spaced Seeds for Database Searching, Read Mapping and Alignment-Free Sequence Comparison.
+ * PLoS Comput Biol 12(10):e1005107. doi:10.1371/journal.pcbi.1005107
+ *
+ * - B. Morgenstern, B. Zhu, S. Horwege, C.-A Leimeister (2015)
+ * Estimating evolutionary distances between genomic sequences from spaced-word matches
+ * Algorithms for Molecular Biology 10, 5. (http://www.almob.org/content/10/1/5/abstract)
+ *
+ *
+ * @author: Lars Hahn - 23.08.2017, Georg-August-Universitaet Goettingen
+ */
+#ifndef OVERLAPHIST_HPP_
+#define OVERLAPHIST_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "pattern.hpp"
+#include "patternset.hpp"
+#include "rasbcomp.hpp"
+
+/**
+ * An object/instance of the overlap histogram class holds for each pattern
+ * pair of a set the number of shifts with overlap k, 0 <= k <= weight. Both
+ * the overlap complexity and the variance only depend on these counts and
+ * the pattern lengths, thus a set can be scored for many parameters P, Q and
+ * S with O(m^2*weight) table operations per parameter tuple.
+ * For a pattern with itself only the non-negative shifts are counted, the
+ * negative shifts have the same overlaps.
+ * The histograms can be written to and read from a file.
+ */
+class overlaphist{
+    public:
+        overlaphist();
+        overlaphist(const patternset & Pattern);
+        overlaphist(std::string HistFile);
+
+        double oc() const;
+        double variance(const rasbhari_compute::var_table & Table) const;
+        void to_file(std::string HistFile) const;
+
+        unsigned size() const;
+        unsigned weight() const;
+
+    private:
+        const uint32_t * _counts(unsigned Idx1, unsigned Idx2) const;
+        template<typename Value>
+        Value _oc() const;
+
+        std::vector<unsigned> _Lengths;
+        std::vector<uint32_t> _Counts;
+        unsigned _Weight;
+};
+
+#endif
@@ -20,26 +20,89 @@
  */
 #include "pattern.hpp"
 
+namespace{
+    /**
+     * Number of zero words appended to a copy of the multi-word bit pattern;
+     * the overlap kernel may read this many words behind the last word.
+     */
+    const unsigned PadWords = 4;
+
+#ifdef __AVX2__
+    /**
+     * Counts the set bits of each 64-bit lane of an AVX2 register.
+     *
+     * @param X             The register.
+     *
+     * @return              The bit counts of the four lanes.
+     */
+    inline __m256i popcount256(__m256i X){
+#if defined(__AVX512VPOPCNTDQ__) && defined(__AVX512VL__)
+        return _mm256_popcnt_epi64(X);
+#else
+        const __m256i Table = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+        const __m256i Low = _mm256_set1_epi8(0x0f);
+        __m256i Counts = _mm256_add_epi8(_mm256_shuffle_epi8(Table, _mm256_and_si256(X, Low)),
+                                         _mm256_shuffle_epi8(Table, _mm256_and_si256(_mm256_srli_epi16(X, 4), Low)));
+        return _mm256_sad_epu8(Counts, _mm256_setzero_si256());
+#endif
+    }
+#endif
+
+    /**
+     * Returns the overlap of two multi-word bit patterns, if the first one is
+     * shifted to the right, i.e. popcount((A >> Shift) & B). Both word arrays
+     * have to be followed by PadWords zero words. With AVX2 four words are
+     * processed at once, thus the costs scale with the length/256.
+     *
+     * @param A             The words of the shifted pattern, lowest first.
+     *
+     * @param WordsA        The number of words of A.
+     *
+     * @param B             The words of the other pattern, lowest first.
+     *
+     * @param WordsB        The number of words of B.
+     *
+     * @param Shift         The number of positions A is shifted.
+     *
+     * @return              The overlap for the shift.
+     */
+    inline unsigned shifted_overlap(const uint64_t * A, unsigned WordsA, const uint64_t * B, unsigned WordsB, unsigned Shift){
+        unsigned Quot = Shift / 64, Rem = Shift % 64;
+        if(Quot >= WordsA){
+            return 0;
+        }
+        unsigned Words = std::min(WordsB, WordsA - Quot), Overlap = 0;
+        A += Quot;
+#ifdef __AVX2__
+        __m128i RightShift = _mm_cvtsi32_si128(Rem), LeftShift = _mm_cvtsi32_si128(64 - Rem);
+        __m256i Sum = _mm256_setzero_si256();
+        for(unsigned w = 0; w < Words; w += 4){
+            __m256i Lower = _mm256_loadu_si256((const __m256i*)(A + w));
+            __m256i Upper = _mm256_loadu_si256((const __m256i*)(A + w + 1));
+            __m256i Shifted = _mm256_or_si256(_mm256_srl_epi64(Lower, RightShift), _mm256_sll_epi64(Upper, LeftShift));
+            Sum = _mm256_add_epi64(Sum, popcount256(_mm256_and_si256(Shifted, _mm256_loadu_si256((const __m256i*)(B + w)))));
+        }
+        uint64_t Lanes[4];
+        _mm256_storeu_si256((__m256i*)Lanes, Sum);
+        Overlap = Lanes[0] + Lanes[1] + Lanes[2] + Lanes[3];
+#else
+        for(unsigned w = 0; w < Words; w++){
+            uint64_t Word = A[w] >> Rem;
+            if(Rem != 0){
+                Word |= A[w + 1] << (64 - Rem);
+            }
+            Overlap += __builtin_popcountll(Word & B[w]);
+        }
+#endif
+        return Overlap;
+    }
+}
+
 /**
  * The empty-constructor, can be used, if symbols should be pushed into the
  * pattern instance.
  */
-pattern::pattern(uint64_t Idx):  _Score(1), _BitPattern(0), _Idx(Idx), _IsBit(false){
-}
-/**
- * The copy-constructor, can be used, if an already existing pattern instance
- * shall be copied.
- *
- * @param Pat       The pattern instance that should be copied.
- */
-pattern::pattern(const pattern & Pat){
-    _VectorPattern = Pat._VectorPattern;
-    _MatchPos = Pat._MatchPos;
-    _DCPos = Pat._DCPos;
-    _Score = Pat._Score;
-    _BitPattern = Pat._BitPattern;
-    _Idx = Pat._Idx;
-    _IsBit = Pat._IsBit;
+pattern::pattern(uint64_t Idx): _Bits(), _Score(1), _Idx(Idx), _Length(0){
 }
 /**
  * The default-constructer; the number of don't care positions and match
@@ -53,7 +116,7 @@ pattern::pattern(const pattern & Pat){
  * @param Index         The index, probabliy used within a set of different
  *                          patterns.
  */
-pattern::pattern(unsigned Weight, unsigned DontCare, unsigned Idx): _Score(1), _BitPattern(0), _Idx(Idx),_IsBit(false){
+pattern::pattern(unsigned Weight, unsigned DontCare, unsigned Idx): _Bits(), _Score(1), _Idx(Idx), _Length(0){
     random(Weight, DontCare);
 }
 /**
@@ -72,18 +135,36 @@ pattern::pattern(unsigned Weight, unsigned DontCare, unsigned Idx): _Score(1), _
  *
  * @param Seed          The seed that is used for the random generator.
  */
-pattern::pattern(unsigned Weight, unsigned DontCare, uint64_t Seed, unsigned Idx): _Score(1), _BitPattern(0), _Idx(Idx), _IsBit(false){
+pattern::pattern(unsigned Weight, unsigned DontCare, uint64_t Seed, unsigned Idx): _Bits(), _Score(1), _Idx(Idx), _Length(0){
     random(Weight, DontCare, Seed);
 }
+/**
+ * The stream-default-constructer; as the seed-default-constructer, but the
+ * pattern is drawn from a passed random stream.
+ *
+ * @param Weight        The weight of a pattern, i.e. the number of '1'.
+ *
+ * @param DontCare      The number of don't care positions in each pattern,
+ *                          i.e. the number of '0'.
+ *
+ * @param Rng           The random stream.
+ *
+ * @param Index         The index, probabliy used within a set of different
+ *                          patterns.
+ */
+pattern::pattern(unsigned Weight, unsigned DontCare, rng & Rng, unsigned Idx): _Bits(), _Score(1), _Idx(Idx), _Length(0){
+    random(Weight, DontCare, Rng);
+}
 /**
  * The string-constructor; the pattern is created from a string representing a
  * binary pattern.
  *
  * @param StrPat        The string pattern transformed into a pattern instance.
  */
-pattern::pattern(std::string & StrPat) : _Score(1), _BitPattern(0),_IsBit(false){
-    _VectorPattern = std::vector<unsigned char>(StrPat.begin(), StrPat.end());
-    _check_pattern();
+pattern::pattern(std::string & StrPat) : _Bits(), _Score(1), _Idx(0), _Length(0){
+    for(unsigned char C : StrPat){
+        push_back(C);
+    }
 }
 /**
  * The string-constructor; the pattern is created from a string representing a
@@ -91,9 +172,10 @@ pattern::pattern(std::string & StrPat) : _Score(1), _BitPattern(0),_IsBit(false)
  *
  * @param StrPat        The string pattern transformed into a pattern instance.
  */
-pattern::pattern(std::string && StrPat) : _Score(1), _BitPattern(0),_IsBit(false){
-    _VectorPattern = std::vector<unsigned char>(StrPat.begin(), StrPat.end());
-    _check_pattern();
+pattern::pattern(std::string && StrPat) : _Bits(), _Score(1), _Idx(0), _Length(0){
+    for(unsigned char C : StrPat){
+        push_back(C);
+    }
 }
 /**
  * The vector-constructor; the pattern is created from a vector representing a
@@ -101,9 +183,10 @@ pattern::pattern(std::string && StrPat) : _Score(1), _BitPattern(0),_IsBit(false
  *
  * @param StrPat        The vector pattern transformed into a pattern instance.
  */
-pattern::pattern(std::vector<char> & StrPat) : _Score(1), _BitPattern(0),_IsBit(false){
-    _VectorPattern = std::vector<unsigned char>(StrPat.begin(), StrPat.end());
-    _check_pattern();
+pattern::pattern(std::vector<char> & StrPat) : _Bits(), _Score(1), _Idx(0), _Length(0){
+    for(unsigned char C : StrPat){
+        push_back(C);
+    }
 }
 /**
  * The vector-constructor; the pattern is created from a vector representing a
@@ -111,9 +194,10 @@ pattern::pattern(std::vector<char> & StrPat) : _Score(1), _BitPattern(0),_IsBit(
  *
  * @param StrPat        The vector pattern transformed into a pattern instance.
  */
-pattern::pattern(std::vector<unsigned char> & StrPat) : _Score(1), _BitPattern(0),_IsBit(false){
-    _VectorPattern = std::vector<unsigned char>(StrPat.begin(), StrPat.end());
-    _check_pattern();
+pattern::pattern(std::vector<unsigned char> & StrPat) : _Bits(), _Score(1), _Idx(0), _Length(0){
+    for(unsigned char C : StrPat){
+        push_back(C);
+    }
 }
 
 
@@ -174,59 +258,73 @@ void pattern::push_back(unsigned char C){
         std::cerr << "Illegal character in pattern!\nFormat: match = {1,X,x,#,*,} | don't care = {0,O,o,-,}" << std::endl;
         std::exit(-1);
     }
-    _VectorPattern.push_back(C);
-    if(C == 1){
-        _MatchPos.push_back(_VectorPattern.size()-1);
+    _check_length(_Length+1);
+    for(unsigned w = MaxWords-1; w > 0; w--){
+        _Bits[w] = (_Bits[w] << 1) | (_Bits[w-1] >> 63);
     }
-    else{
-        _DCPos.push_back(_VectorPattern.size()-1);
-    }
-    _BitPattern <<= 1;
-    _BitPattern |= C;
+    _Bits[0] = (_Bits[0] << 1) | C;
+    _Length++;
 }
 
 /**
- * Checks, if the pattern is in correct format. This is used, if an entire
- * vector or string is used in the constuctor.
+ * Checks, if a pattern of the passed length can be stored; longer patterns
+ * are rejected.
+ *
+ * @param Length        The length of the pattern.
  */
-void pattern::_check_pattern(){
-    unsigned Ctr = 0;
-
-    if(_VectorPattern.size() < 64){
-        _IsBit = true;
-    }
-
-    for(auto & C : _VectorPattern){
-        switch(C){
-            case '1':
-            case 'X':
-            case 'x':
-            case '#':
-            case '*':
-                C = 1;
-                break;
-            case '0':
-            case 'O':
-            case 'o':
-            case '-':
-                C = 0;
-                break;
-        }
-        if(C != 1 && C != 0){
-            std::cerr << "Illegal character in pattern!\nFormat: match = {1,X,x,#,*,} | don't care = {0,O,o,-,}" << std::endl;
-            std::exit(-1);
-        }
-        if(C == 1){
-            _MatchPos.push_back(Ctr);
-        }
-        else{
-            _DCPos.push_back(Ctr);
-        }
-        _BitPattern <<= 1;
-        _BitPattern |= C;
-        Ctr++;
+void pattern::_check_length(unsigned Length) const{
+    if(Length > MaxLength){
+        std::cerr << "Illegal pattern length!\nMaximum allowed length is " << MaxLength << "!" << std::endl;
+        std::exit(-1);
     }
 }
+/**
+ * Mixes a word of a long pattern with its position into a key part; the
+ * parts of all words are combined by xor.
+ *
+ * @param Word          The index of the word.
+ *
+ * @param Bits          The bits of the word.
+ *
+ * @return              The mixed key part.
+ */
+uint64_t pattern::_mix_word(unsigned Word, uint64_t Bits){
+    uint64_t Key = Bits + 0x9e3779b97f4a7c15ULL*(Word+1);
+    Key = (Key ^ (Key >> 30))*0xbf58476d1ce4e5b9ULL;
+    Key = (Key ^ (Key >> 27))*0x94d049bb133111ebULL;
+    return Key ^ (Key >> 31);
+}
+/**
+ * Returns the number of words used by the bit mask.
+ *
+ * @return              The number of used words.
+ */
+unsigned pattern::_words() const{
+    return (_Length+63)/64;
+}
+/**
+ * Copies the bit mask into a buffer, that is followed by PadWords zero words,
+ * as needed by the multi-word overlap kernel.
+ *
+ * @param Buffer        Buffer of MaxWords+PadWords words.
+ *
+ * @return              Pointer to the lowest word.
+ */
+const uint64_t * pattern::_words(uint64_t * Buffer) const{
+    std::copy(_Bits, _Bits+MaxWords, Buffer);
+    std::fill(Buffer+MaxWords, Buffer+MaxWords+PadWords, 0);
+    return Buffer;
+}
+/**
+ * Inverts a position of the pattern; the position i is stored at the bit
+ * length()-1-i of the mask.
+ *
+ * @param Pos           The position to be inverted.
+ */
+void pattern::_flip(unsigned Pos){
+    unsigned Bit = _Length-1-Pos;
+    _Bits[Bit/64] ^= (uint64_t)1 << (Bit%64);
+}
 
 /**
  * Creates a random pattern from passed pattern parameters.
@@ -237,8 +335,7 @@ void pattern::_check_pattern(){
  *                          '0's.
  */
 void pattern::random(unsigned Weight, unsigned DontCare){
-    std::random_device RandomBit;
-    random(Weight, DontCare, RandomBit());
+    random(Weight, DontCare, rng::thread_stream());
 }
 /**
  * Creates a random pattern from passed pattern parameters using a passed
@@ -253,42 +350,38 @@ void pattern::random(unsigned Weight, unsigned DontCare){
  *                          random intialised pattern instance.
  */
 void pattern::random(unsigned Weight, unsigned DontCare, uint64_t Seed){
+    rng Rng(Seed);
+    random(Weight, DontCare, Rng);
+}
+/**
+ * Creates a random pattern from passed pattern parameters, drawing the match
+ * positions from a passed random stream.
+ *
+ * @param Weight        The weight of the pattern, i.e. the number of '1's
+ *
+ * @param DontCare      The number of don't care positions, i.e. the number of
+ *                          '0's.
+ *
+ * @param Rng           The random stream.
+ */
+void pattern::random(unsigned Weight, unsigned DontCare, rng & Rng){
     unsigned Length = DontCare + Weight;
-    if(Length < 64){
-        _IsBit = true;
-    }
     if(Weight < 2){
         std::cerr << "Illegal value for weight!\nMinimum allowed weight is 2!" << std::endl;
         std::exit(-1);
     }
-    std::default_random_engine BitRandom(Seed);
-    std::mt19937 BitGenerator(BitRandom());
-    std::uniform_int_distribution<unsigned> BitPosition(1, Length-2);
-
-    _MatchPos.clear();
-    _DCPos.clear();
-    _BitPattern = 0;
-    _VectorPattern = std::vector<unsigned char>(Length,0);
-    
-    _VectorPattern[0] = 1;
-    _VectorPattern[Length-1] = 1;
-    _BitPattern = ((uint64_t) 1 << (Length-1)) | (uint64_t)1;
+    _check_length(Length);
+    std::fill(_Bits, _Bits+MaxWords, 0);
+    _Length = Length;
+    _flip(0);
+    _flip(Length-1);
     Weight -= 2;
 
     while(Weight > 0){
-        unsigned Pos = BitPosition(BitGenerator);
-        if(_VectorPattern[Pos] == 0){
+        unsigned Pos = 1 + Rng.below(Length-2);
+        if(!is_match(Pos)){
             Weight--;
-            _VectorPattern[Pos] = 1;
-            _BitPattern |= (uint64_t)1 << (Length -1 - Pos);
-        }
-    }
-    for(unsigned i = 0; i < _VectorPattern.size(); i++){
-        if(_VectorPattern[i] == 1){
-            _MatchPos.push_back(i);
-        }
-        else{
-            _DCPos.push_back(i);
+            _flip(Pos);
         }
     }
 }
@@ -299,8 +392,10 @@ void pattern::random(unsigned Weight, unsigned DontCare, uint64_t Seed){
  * @return              The string representation of the pattern instance.
  */
 std::string pattern::to_string() const{
-    std::string Pattern(_VectorPattern.begin(), _VectorPattern.end());
-    std::transform(Pattern.begin(), Pattern.end(), Pattern.begin(),[](unsigned char C) { return (C+'0'); });
+    std::string Pattern(_Length, '0');
+    for(unsigned Pos : match_pos()){
+        Pattern[Pos] = '1';
+    }
     return Pattern;
 }
 
@@ -313,24 +408,25 @@ std::string pattern::to_string() const{
  * @return              True, if the requested position is a match position.
  */
 bool pattern::is_match(unsigned Pos) const{
-    return _VectorPattern[Pos] == 1;
+    unsigned Bit = _Length-1-Pos;
+    return (_Bits[Bit/64] >> (Bit%64)) & 1;
 }
 
 /**
- * Returns a list containing indices, where a match position is found.
+ * Returns a view on the indices, where a match position is found.
  *
- * @return              Integer list of all match positions.
+ * @return              View of all match positions, in ascending order.
  */
-std::vector<unsigned> pattern::match_pos() const{
-    return _MatchPos;
+pattern::positions pattern::match_pos() const{
+    return positions(_Bits, _Length, true);
 }
 /**
- * Returns a list containing indices, where a don't-care position is found.
+ * Returns a view on the indices, where a don't-care position is found.
  *
- * @return              Integer list of all don't care positions.
+ * @return              View of all don't care positions, in ascending order.
  */
-std::vector<unsigned> pattern::dc_pos() const{
-    return _DCPos;
+pattern::positions pattern::dc_pos() const{
+    return positions(_Bits, _Length, false);
 }
 
 /**
@@ -342,18 +438,9 @@ std::vector<unsigned> pattern::dc_pos() const{
  * @param PosB          The second position to be swapped.
  */
 void pattern::bit_swap(unsigned PosA, unsigned PosB){
-    std::swap(_VectorPattern[PosA],_VectorPattern[PosB]);
-    if(_IsBit && _VectorPattern[PosA] !=_VectorPattern[PosB]){
-        _BitPattern ^= ((uint64_t)1 << (_VectorPattern.size()-PosA-1)) | ((uint64_t)1 << (_VectorPattern.size()-PosB-1));
-        if(_VectorPattern[PosA] != 0){
-            std::swap(PosA,PosB);
-        }
-        _MatchPos.erase(std::find(_MatchPos.begin(), _MatchPos.end(), PosA));
-        _DCPos.erase(std::find(_DCPos.begin(), _DCPos.end(), PosB));
-        _MatchPos.push_back(PosB);
-        _DCPos.push_back(PosA);
-        std::sort(_MatchPos.begin(), _MatchPos.end());
-        std::sort(_DCPos.begin(), _DCPos.end());
+    if(is_match(PosA) != is_match(PosB)){
+        _flip(PosA);
+        _flip(PosB);
     }
 }
 
@@ -362,8 +449,8 @@ void pattern::bit_swap(unsigned PosA, unsigned PosB){
  * One position is a match position, the other one is a don't care position.
  */
 void pattern::random_swap(){
-    std::random_device RandomBit;
-    random_swap(RandomBit());
+    unsigned MatchPos, DCPos;
+    random_swap(rng::thread_stream(), MatchPos, DCPos);
 }
 
 /**
@@ -372,39 +459,107 @@ void pattern::random_swap(){
  * One position is a match position, the other one is a don't care position.
  */
 void pattern::random_swap(uint64_t Seed){
-    if(_DCPos.size() != 0 && _MatchPos.size() > 2){
-        std::default_random_engine BitRandom(Seed);
-        std::mt19937 BitGenerator(BitRandom());
-        std::uniform_int_distribution<unsigned> SwapPosition(1, _MatchPos.size()-2);
-        unsigned MatchPosition = _MatchPos[SwapPosition(BitGenerator)];
-        SwapPosition = std::uniform_int_distribution<unsigned>(0, _DCPos.size()-1);
-        unsigned DCPosition = _DCPos[SwapPosition(BitGenerator)];
-        bit_swap(MatchPosition, DCPosition);
+    unsigned MatchPos, DCPos;
+    random_swap(Seed, MatchPos, DCPos);
+}
+/**
+ * Performs a random bit swap for two distinct positions and returns the
+ * swapped positions.
+ *
+ * @param MatchPos      Returns the former match position, now a don't care.
+ *
+ * @param DCPos         Returns the former don't care position, now a match.
+ *
+ * @return              True, if a swap was performed.
+ */
+bool pattern::random_swap(unsigned & MatchPos, unsigned & DCPos){
+    return random_swap(rng::thread_stream(), MatchPos, DCPos);
+}
+/**
+ * Performs a random bit swap for two distinct positions using a passed seed
+ * and returns the swapped positions.
+ *
+ * @param Seed          The seed used for the random generator.
+ *
+ * @param MatchPos      Returns the former match position, now a don't care.
+ *
+ * @param DCPos         Returns the former don't care position, now a match.
+ *
+ * @return              True, if a swap was performed.
+ */
+bool pattern::random_swap(uint64_t Seed, unsigned & MatchPos, unsigned & DCPos){
+    rng Rng(Seed);
+    return random_swap(Rng, MatchPos, DCPos);
+}
+/**
+ * Performs a random bit swap for two distinct positions drawn from a passed
+ * random stream and returns the swapped positions.
+ *
+ * @param Rng           The random stream.
+ *
+ * @param MatchPos      Returns the former match position, now a don't care.
+ *
+ * @param DCPos         Returns the former don't care position, now a match.
+ *
+ * @return              True, if a swap was performed.
+ */
+bool pattern::random_swap(rng & Rng, unsigned & MatchPos, unsigned & DCPos){
+    if(random_positions(Rng, MatchPos, DCPos)){
+        bit_swap(MatchPos, DCPos);
+        return true;
     }
+    return false;
 }
-
-
 /**
- * Random access operator, that returns the symbol from a specific
- * position in the pattern.
+ * Draws the positions of a random bit swap using a passed seed, without
+ * performing the swap; the pattern is not changed. The same positions are
+ * drawn as by random_swap() for the same seed.
  *
- * @param Idx           The index number of a symbol, that sould be returned.
+ * @param Seed          The seed used for the random generator.
  *
- * @return              The symbol from the Idx-th position; constant
+ * @param MatchPos      Returns the match position, that would become a don't care.
+ *
+ * @param DCPos         Returns the don't care position, that would become a match.
+ *
+ * @return              True, if a swap is possible for this pattern.
  */
-unsigned char pattern::operator[](size_t Idx) const{
-    return _VectorPattern[Idx];
+bool pattern::random_positions(uint64_t Seed, unsigned & MatchPos, unsigned & DCPos) const{
+    rng Rng(Seed);
+    return random_positions(Rng, MatchPos, DCPos);
+}
+/**
+ * Draws the positions of a random bit swap from a passed random stream,
+ * without performing the swap; the pattern is not changed.
+ *
+ * @param Rng           The random stream.
+ *
+ * @param MatchPos      Returns the match position, that would become a don't care.
+ *
+ * @param DCPos         Returns the don't care position, that would become a match.
+ *
+ * @return              True, if a swap is possible for this pattern.
+ */
+bool pattern::random_positions(rng & Rng, unsigned & MatchPos, unsigned & DCPos) const{
+    unsigned Weight = weight(), DontCare = _Length - Weight;
+    if(DontCare != 0 && Weight > 2){
+        MatchPos = match_pos()[1 + Rng.below(Weight-2)];
+        DCPos = dc_pos()[Rng.below(DontCare)];
+        return true;
+    }
+    return false;
 }
+
+
 /**
  * Random access operator, that returns the symbol from a specific
  * position in the pattern.
  *
  * @param Idx           The index number of a symbol, that sould be returned.
  *
- * @return              The symbol from the Idx-th position; r-value
+ * @return              The symbol from the Idx-th position; constant
  */
-unsigned char & pattern::operator[](size_t Idx){
-    return _VectorPattern[Idx];
+unsigned char pattern::operator[](size_t Idx) const{
+    return is_match(Idx) ? 1 : 0;
 }
 /**
  * Compares the score of the pattern with another one and returns true,
@@ -436,10 +591,7 @@ bool pattern::operator>(const pattern & P) const{
  * @return              True, if the other pattern is identical to this one.
  */
 bool pattern::operator==(const pattern & P) const{
-    if(_IsBit){
-        return _BitPattern == P._BitPattern;
-    }
-    return _VectorPattern == P._VectorPattern;
+    return _Length == P._Length && std::equal(_Bits, _Bits+MaxWords, P._Bits);
 }
 /**
  * Compares another pattern with this pattern if they are not identical.
@@ -449,10 +601,7 @@ bool pattern::operator==(const pattern & P) const{
  * @return              True, if the other pattern is not identical to this one.
  */
 bool pattern::operator!=(const pattern & P) const{
-    if(_IsBit){
-        return _BitPattern != P._BitPattern;
-    }
-    return _VectorPattern != P._VectorPattern;
+    return !(*this == P);
 }
 
 /**
@@ -470,7 +619,69 @@ double pattern::score() const{
  * @return              Bit-Integer pattern representation
  */
 uint64_t pattern::bits() const{
-    return _BitPattern;
+    return _Bits[0];
+}
+/**
+ * Returns a 64 bit key of the pattern, used for hashing pattern sets.
+ * For patterns shorter than 64 positions the key is the bit pattern itself,
+ * so two patterns of the same length are identical, iff their keys are.
+ * Longer patterns mix each word into the key, here equal keys only indicate
+ * identical patterns.
+ *
+ * @return              The key of the pattern.
+ */
+uint64_t pattern::key() const{
+    if(_Length < 64){
+        return _Bits[0];
+    }
+    uint64_t Key = 0;
+    for(unsigned w = 0; w < _words(); w++){
+        Key ^= _mix_word(w, _Bits[w]);
+    }
+    return Key;
+}
+/**
+ * Returns the key of the pattern, as key() would after bit_swap(PosA, PosB),
+ * without performing the swap.
+ *
+ * @param PosA          The first position of the swap.
+ *
+ * @param PosB          The second position of the swap.
+ *
+ * @return              The key of the swapped pattern.
+ */
+uint64_t pattern::swap_key(unsigned PosA, unsigned PosB) const{
+    if(is_match(PosA) == is_match(PosB)){
+        return key();
+    }
+    unsigned BitA = _Length-PosA-1, BitB = _Length-PosB-1;
+    if(_Length < 64){
+        return _Bits[0] ^ ((uint64_t)1 << BitA) ^ ((uint64_t)1 << BitB);
+    }
+    uint64_t Key = 0;
+    for(unsigned w = 0; w < _words(); w++){
+        uint64_t Word = _Bits[w];
+        if(BitA/64 == w){
+            Word ^= (uint64_t)1 << (BitA%64);
+        }
+        if(BitB/64 == w){
+            Word ^= (uint64_t)1 << (BitB%64);
+        }
+        Key ^= _mix_word(w, Word);
+    }
+    return Key;
+}
+/**
+ * Writes the bit pattern into a fixed number of words, ordered from the
+ * lowest to the highest bits; unused words are set to zero.
+ *
+ * @param Words         Array of Count words.
+ *
+ * @param Count         The number of words to be written.
+ */
+void pattern::get_words(uint64_t * Words, unsigned Count) const{
+    std::fill(Words, Words+Count, 0);
+    std::copy(_Bits, _Bits + std::min(Count, _words()), Words);
 }
 /**
  * Returns the weight of the pattern
@@ -478,7 +689,11 @@ uint64_t pattern::bits() const{
  * @return              The pattern weight, i.e. the number of '1's.
  */
 unsigned pattern::weight() const{
-    return _MatchPos.size();
+    unsigned Weight = 0;
+    for(unsigned w = 0; w < MaxWords; w++){
+        Weight += __builtin_popcountll(_Bits[w]);
+    }
+    return Weight;
 }
 /**
  * Returns the lenght of the pattern
@@ -486,7 +701,7 @@ unsigned pattern::weight() const{
  * @return              The pattern length, the sum of weight and DC positions.
  */
 unsigned pattern::length() const{
-    return _VectorPattern.size();
+    return _Length;
 }
 /**
  * Returns the number of don't care positons of the pattern
@@ -495,7 +710,7 @@ unsigned pattern::length() const{
  *                          '1's.
  */
 unsigned pattern::dontcare() const{
-    return _VectorPattern.size() - _MatchPos.size();
+    return _Length - weight();
 }
 /**
  * Returns the index of the pattern, that was set before.
@@ -539,52 +754,64 @@ void pattern::set_idx(unsigned Idx){
 unsigned pattern::get_overlap(const pattern & P, int OldShift) const{
     unsigned Overlap = 0;
     int Shift =  (int)length() - ((int)P.length()+OldShift);
-    if(P._IsBit && _IsBit){
+    if(_Length < 64 && P._Length < 64){
         uint64_t ShiftPattern = bits();
         uint64_t BitPat = P.bits();
         if(Shift < 0){
             std::swap(ShiftPattern, BitPat);
             Shift = std::abs(Shift);
         }
-        ShiftPattern >>= Shift;
-        ShiftPattern &= BitPat;
-        unsigned ShiftSize = std::log2(ShiftPattern)+1;
-        for(unsigned i = 0; i < ShiftSize; i++){
-            Overlap += (ShiftPattern & (uint64_t)1);
-            ShiftPattern >>= 1;
-        }
+        Overlap = __builtin_popcountll((ShiftPattern >> Shift) & BitPat);
     }
     else{
-        auto PatAIt = _VectorPattern.begin();
-        auto PatBIt = P._VectorPattern.begin();
-        Shift += (int)P._VectorPattern.size()-(int)_VectorPattern.size();
-        if(Shift > 0){
-            PatBIt += Shift;
+        uint64_t BufferA[MaxWords+PadWords], BufferB[MaxWords+PadWords];
+        const uint64_t * WordsA = _words(BufferA), * WordsB = P._words(BufferB);
+        unsigned NumA = (length()+63)/64, NumB = (P.length()+63)/64;
+        if(Shift < 0){
+            Overlap = shifted_overlap(WordsB, NumB, WordsA, NumA, -Shift);
         }
         else{
-            PatAIt -= Shift;
-        }
-        for(;PatAIt != _VectorPattern.end() && PatBIt != P._VectorPattern.end(); PatBIt++, PatAIt++){
-            Overlap += *PatAIt * *PatBIt;
+            Overlap = shifted_overlap(WordsA, NumA, WordsB, NumB, Shift);
         }
     }
     return Overlap;
 }
-
-
 /**
- * Begin iterator that can be used to iterate over the pattern.
+ * Returns the overlaps for this pattern with another pattern for all possible
+ * shifts at once, i.e. for each shift s with -P.length() < s < length() the
+ * value get_overlap(P,s) is stored at position s+P.length()-1.
+ * In bit mode each entry is a single AND and popcount of the shifted bit
+ * patterns, otherwise of the shifted multi-word bit patterns.
  *
- * @return              The begin iterator of the pattern symbol vector.
- */
-pattern::iterator pattern::begin(){
-    return _VectorPattern.begin();
-}
-/**
- * End iterator that can be used to iterate over the pattern.
+ * @param P             The pattern used for calculating the overlaps
  *
- * @return              The end iterator of the pattern symbol vector.
+ * @param Overlaps      Vector, that is resized and filled with the overlap
+ *                          of every shift.
  */
-pattern::iterator pattern::end(){
-    return _VectorPattern.end();
+void pattern::get_overlaps(const pattern & P, std::vector<unsigned> & Overlaps) const{
+    unsigned LengthA = length(), LengthB = P.length();
+    Overlaps.resize(LengthA + LengthB - 1);
+    if(_Length < 64 && P._Length < 64){
+        uint64_t BitPatA = bits();
+        uint64_t BitPatB = P.bits();
+        unsigned *Out = Overlaps.data();
+        for(unsigned Shift = LengthA; Shift-- > 0;){
+            *Out++ = __builtin_popcountll((BitPatA >> Shift) & BitPatB);
+        }
+        for(unsigned Shift = 1; Shift < LengthB; Shift++){
+            *Out++ = __builtin_popcountll((BitPatB >> Shift) & BitPatA);
+        }
+    }
+    else{
+        uint64_t BufferA[MaxWords+PadWords], BufferB[MaxWords+PadWords];
+        const uint64_t * WordsA = _words(BufferA), * WordsB = P._words(BufferB);
+        unsigned NumA = (LengthA+63)/64, NumB = (LengthB+63)/64;
+        unsigned *Out = Overlaps.data();
+        for(unsigned Shift = LengthA; Shift-- > 0;){
+            *Out++ = shifted_overlap(WordsA, NumA, WordsB, NumB, Shift);
+        }
+        for(unsigned Shift = 1; Shift < LengthB; Shift++){
+            *Out++ = shifted_overlap(WordsB, NumB, WordsA, NumA, Shift);
+        }
+    }
 }
\ No newline at end of file
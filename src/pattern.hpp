@@ -25,10 +25,16 @@
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
+#include <iterator>
 #include <random>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
+#include "rng.hpp"
+#if defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 /**
  * An object/instance of the pattern class represents a binary pattern that
@@ -37,14 +43,20 @@
  * Lists of don't-care positions and match positons can be requested.
  * Random patterns can be initialised depending on passed parameter 
  * configurations.
- * Iterators can be used to iterate symbol wise over a pattern.
+ *
+ * The pattern is stored as a bit mask of at most MaxLength positions and its
+ * length, without any heap memory, so a pattern is trivially copyable. The
+ * match and don't care positions are views on the bit mask.
  */
 class pattern{
     public:
+        class positions;
+        static const unsigned MaxLength = 256;
+
         pattern(uint64_t Idx = 0);
-        pattern(const pattern & Pat);
         pattern(unsigned Weight, unsigned DontCare,unsigned Idx = 0);
         pattern(unsigned Weight, unsigned DontCare, uint64_t Seed, unsigned Idx = 0);
+        pattern(unsigned Weight, unsigned DontCare, rng & Rng, unsigned Idx = 0);
         pattern(std::string & StrPat);
         pattern(std::string && StrPat);
         pattern(std::vector<char> & StrPat);
@@ -56,18 +68,23 @@ class pattern{
         void push_back(unsigned char C);
 
         std::string to_string() const;
-        std::vector<unsigned> match_pos() const;
-        std::vector<unsigned> dc_pos() const;
+        positions match_pos() const;
+        positions dc_pos() const;
         bool is_match(unsigned Pos) const;
         void bit_swap(unsigned PosA, unsigned PosB);
         void random_swap();
         void random_swap(uint64_t Seed);
+        bool random_swap(unsigned & MatchPos, unsigned & DCPos);
+        bool random_swap(uint64_t Seed, unsigned & MatchPos, unsigned & DCPos);
+        bool random_swap(rng & Rng, unsigned & MatchPos, unsigned & DCPos);
+        bool random_positions(uint64_t Seed, unsigned & MatchPos, unsigned & DCPos) const;
+        bool random_positions(rng & Rng, unsigned & MatchPos, unsigned & DCPos) const;
 
         void random(unsigned Weight, unsigned DontCare);
         void random(unsigned Weight, unsigned DontCare, uint64_t Seed);
+        void random(unsigned Weight, unsigned DontCare, rng & Rng);
 
         unsigned char operator[](size_t Idx) const;
-        unsigned char & operator[](size_t Idx);
         bool operator<(const pattern & P) const;
         bool operator>(const pattern & P) const;
         bool operator==(const pattern & P) const;
@@ -75,28 +92,223 @@ class pattern{
 
         double score() const;
         uint64_t bits() const;
+        uint64_t key() const;
+        uint64_t swap_key(unsigned PosA, unsigned PosB) const;
         unsigned weight() const;
         unsigned length() const;
         unsigned dontcare() const;
         unsigned get_overlap(const pattern & P, int Shift) const;
+        void get_overlaps(const pattern & P, std::vector<unsigned> & Overlaps) const;
+        template<unsigned Words>
+        void get_fixed_overlaps(const pattern & P, unsigned * Overlaps) const;
+        void get_words(uint64_t * Words, unsigned Count) const;
         unsigned idx() const;
         void set_score(double Scr);
         void set_idx(unsigned Idx);
 
-        typedef std::vector<unsigned char>::iterator iterator;
-        iterator begin();
-        iterator end();
-
-
     private:
-        void _check_pattern();
+        static const unsigned MaxWords = MaxLength/64;
+        void _check_length(unsigned Length) const;
+        unsigned _words() const;
+        const uint64_t * _words(uint64_t * Buffer) const;
+        void _flip(unsigned Pos);
+        static uint64_t _mix_word(unsigned Word, uint64_t Bits);
 
-        std::vector<unsigned char> _VectorPattern;
-        std::vector<unsigned> _MatchPos;
-        std::vector<unsigned> _DCPos;
+        uint64_t _Bits[MaxWords];
         double _Score;
-        uint64_t _BitPattern;
         unsigned _Idx;
-        bool _IsBit;
+        unsigned _Length;
 };
+
+/**
+ * A view on the match or the don't care positions of a pattern, that can be
+ * iterated in ascending order and indexed, without creating a list. The view
+ * holds a copy of the bit mask, thus it stays valid without the pattern.
+ */
+class pattern::positions{
+    public:
+        class iterator;
+        positions(const uint64_t * Bits, unsigned Length, bool Match);
+
+        iterator begin() const;
+        iterator end() const;
+        unsigned size() const;
+        unsigned operator[](unsigned Rank) const;
+
+    private:
+        uint64_t _Bits[MaxWords];
+        unsigned _Length;
+};
+
+/**
+ * Forward iterator over the positions of a view; the set bits are visited
+ * from the highest to the lowest, which are the positions in ascending order.
+ */
+class pattern::positions::iterator{
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef unsigned value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const unsigned * pointer;
+        typedef unsigned reference;
+
+        iterator(const uint64_t * Bits, int Word, unsigned Length);
+        unsigned operator*() const;
+        iterator & operator++();
+        iterator operator++(int);
+        bool operator==(const iterator & It) const;
+        bool operator!=(const iterator & It) const;
+
+    private:
+        void _skip();
+        const uint64_t * _Bits;
+        uint64_t _Rest;
+        int _Word;
+        unsigned _Length;
+};
+
+/**
+ * Creates a view on the set bits of Bits; for don't care positions the bits
+ * within the length are inverted.
+ *
+ * @param Bits          The bit mask of the pattern, MaxWords words.
+ *
+ * @param Length        The length of the pattern.
+ *
+ * @param Match         True for the match positions, false for the don't
+ *                          care positions.
+ */
+inline pattern::positions::positions(const uint64_t * Bits, unsigned Length, bool Match): _Length(Length){
+    for(unsigned w = 0; w < MaxWords; w++){
+        unsigned Used = Length > 64*w ? std::min(Length - 64*w, 64u) : 0;
+        uint64_t Mask = Used == 64 ? ~(uint64_t)0 : ((uint64_t)1 << Used) - 1;
+        _Bits[w] = (Match ? Bits[w] : ~Bits[w]) & Mask;
+    }
+}
+inline pattern::positions::iterator pattern::positions::begin() const{
+    return iterator(_Bits, MaxWords-1, _Length);
+}
+inline pattern::positions::iterator pattern::positions::end() const{
+    return iterator(_Bits, -1, _Length);
+}
+/**
+ * Returns the number of positions in the view.
+ *
+ * @return              The number of positions.
+ */
+inline unsigned pattern::positions::size() const{
+    unsigned Size = 0;
+    for(unsigned w = 0; w < MaxWords; w++){
+        Size += __builtin_popcountll(_Bits[w]);
+    }
+    return Size;
+}
+/**
+ * Returns the Rank-th position of the view in ascending order; with BMI2 the
+ * bit is selected within its word by a parallel bit deposit.
+ *
+ * @param Rank          The rank of the position; smaller than size().
+ *
+ * @return              The position.
+ */
+inline unsigned pattern::positions::operator[](unsigned Rank) const{
+    for(int w = MaxWords-1; w >= 0; w--){
+        unsigned Count = __builtin_popcountll(_Bits[w]);
+        if(Rank < Count){
+            unsigned Low = Count-1-Rank;
+#ifdef __BMI2__
+            unsigned Bit = __builtin_ctzll(_pdep_u64((uint64_t)1 << Low, _Bits[w]));
+#else
+            uint64_t Word = _Bits[w];
+            for(unsigned i = 0; i < Low; i++){
+                Word &= Word-1;
+            }
+            unsigned Bit = __builtin_ctzll(Word);
+#endif
+            return _Length-1-(64*w+Bit);
+        }
+        Rank -= Count;
+    }
+    return _Length;
+}
+
+inline pattern::positions::iterator::iterator(const uint64_t * Bits, int Word, unsigned Length):
+    _Bits(Bits), _Rest(Word >= 0 ? Bits[Word] : 0), _Word(Word), _Length(Length){
+    _skip();
+}
+inline unsigned pattern::positions::iterator::operator*() const{
+    return _Length-1-(64*_Word + 63-__builtin_clzll(_Rest));
+}
+inline pattern::positions::iterator & pattern::positions::iterator::operator++(){
+    _Rest &= ~((uint64_t)1 << (63-__builtin_clzll(_Rest)));
+    _skip();
+    return *this;
+}
+inline pattern::positions::iterator pattern::positions::iterator::operator++(int){
+    iterator It = *this;
+    ++(*this);
+    return It;
+}
+inline bool pattern::positions::iterator::operator==(const iterator & It) const{
+    return _Word == It._Word && _Rest == It._Rest;
+}
+inline bool pattern::positions::iterator::operator!=(const iterator & It) const{
+    return !(*this == It);
+}
+/**
+ * Moves to the next word with a set bit; behind the last one the word index
+ * is -1, which is the end of the view.
+ */
+inline void pattern::positions::iterator::_skip(){
+    while(_Rest == 0 && _Word >= 0){
+        _Word--;
+        _Rest = _Word >= 0 ? _Bits[_Word] : 0;
+    }
+}
+
+/**
+ * Returns the overlaps for this pattern with another pattern for all possible
+ * shifts, as get_overlaps(), for patterns with at most 64*Words positions.
+ * The bit patterns are held in Words registers and shifted by one position
+ * for each shift; as Words is known at compile time, the loops over the
+ * words are unrolled and no length checks are needed.
+ *
+ * @param P             The pattern used for calculating the overlaps
+ *
+ * @param Overlaps      Array of length()+P.length()-1 entries, that is filled
+ *                          with the overlap of every shift.
+ */
+template<unsigned Words>
+void pattern::get_fixed_overlaps(const pattern & P, unsigned * Overlaps) const{
+    uint64_t BitPatA[Words], BitPatB[Words], Shifted[Words];
+    unsigned LengthA = length(), LengthB = P.length();
+    get_words(BitPatA, Words);
+    P.get_words(BitPatB, Words);
+
+    std::copy(BitPatA, BitPatA+Words, Shifted);
+    for(unsigned Shift = 0; Shift < LengthA; Shift++){
+        unsigned Overlap = 0;
+        for(unsigned w = 0; w < Words; w++){
+            Overlap += __builtin_popcountll(Shifted[w] & BitPatB[w]);
+        }
+        Overlaps[LengthA-1-Shift] = Overlap;
+        for(unsigned w = 0; w+1 < Words; w++){
+            Shifted[w] = (Shifted[w] >> 1) | (Shifted[w+1] << 63);
+        }
+        Shifted[Words-1] >>= 1;
+    }
+    std::copy(BitPatB, BitPatB+Words, Shifted);
+    for(unsigned Shift = 1; Shift < LengthB; Shift++){
+        for(unsigned w = 0; w+1 < Words; w++){
+            Shifted[w] = (Shifted[w] >> 1) | (Shifted[w+1] << 63);
+        }
+        Shifted[Words-1] >>= 1;
+        unsigned Overlap = 0;
+        for(unsigned w = 0; w < Words; w++){
+            Overlap += __builtin_popcountll(Shifted[w] & BitPatA[w]);
+        }
+        Overlaps[LengthA-1+Shift] = Overlap;
+    }
+}
+static_assert(std::is_trivially_copyable<pattern>::value, "pattern has to be trivially copyable");
 #endif
\ No newline at end of file
@@ -24,23 +24,9 @@
  * The empty-constructor, can be used, if patterns should be pushed into the
  * pattern set instance.
  */
-patternset::patternset():_Score(1),_MinWeight(std::numeric_limits<unsigned>::max()),_MaxWeight(0),
+patternset::patternset():_UsedKeys(0),_Hash(0),_Score(1),_MinWeight(std::numeric_limits<unsigned>::max()),_MaxWeight(0),
     _MinDontCare(std::numeric_limits<unsigned>::max()),_MaxDontCare(0){    
 }
-/**
- * The copy-constructor, can be used, if an already existing pattern set instance
- * shall be copied.
- *
- * @param PatSet       The pattern set instance that should be copied.
- */
-patternset::patternset(const patternset & PatSet){
-    _PatternSet = PatSet._PatternSet;
-    _Score = PatSet._Score;
-    _MinWeight = PatSet._MinWeight;
-    _MaxWeight = PatSet._MaxWeight;
-    _MinDontCare = PatSet._MinDontCare;
-    _MaxDontCare = PatSet._MaxDontCare;
-}
 /**
  * The short-default-constructer; here all patterns have the same length and the
  * same weight. A random pattern set will be created.
@@ -55,7 +41,7 @@ patternset::patternset(const patternset & PatSet){
  *                          pattern.
  */
 patternset::patternset(unsigned Size, unsigned Weight, unsigned DontCare, bool Uniq):
-    _Score(1),_MinWeight(Weight),_MaxWeight(Weight),_MinDontCare(DontCare),
+    _UsedKeys(0),_Hash(0),_Score(1),_MinWeight(Weight),_MaxWeight(Weight),_MinDontCare(DontCare),
     _MaxDontCare(DontCare){
     random(Size, Weight, DontCare);
 }
@@ -78,12 +64,38 @@ patternset::patternset(unsigned Size, unsigned Weight, unsigned DontCare, bool U
  *                          pattern.
  */
 patternset::patternset(unsigned Size, unsigned MinW, unsigned MaxW, 
-    unsigned MinD, unsigned MaxD, bool Uniq):_Score(1),_MinWeight(MinW),
+    unsigned MinD, unsigned MaxD, bool Uniq):_UsedKeys(0),_Hash(0),_Score(1),_MinWeight(MinW),
     _MaxWeight(MaxW),_MinDontCare(MinD),_MaxDontCare(MaxD){
     _adjust(_MinWeight,_MaxWeight);
     _adjust(_MinDontCare,_MaxDontCare);
     random(Size, MaxW, MinW, MaxD, MinD);
 }
+/**
+ * The long-default-constructer, drawing the random patterns from a passed
+ * random stream; used for reproducible runs.
+ *
+ * @param Size          The number of patterns.
+ *
+ * @param MinW          The minimal weight for a pattern.
+ *
+ * @param MaxW          The maximal weight for a pattern.
+ *
+ * @param MinD          The minimal number of don't care positions for patterns.
+ *
+ * @param MaxD          The maximal number of don't care positions for patterns.
+ *
+ * @param Uniq          Boolean; true, if each pattern has to be a unique
+ *                          pattern.
+ *
+ * @param Rng           The random stream.
+ */
+patternset::patternset(unsigned Size, unsigned MinW, unsigned MaxW, 
+    unsigned MinD, unsigned MaxD, bool Uniq, rng & Rng):_UsedKeys(0),_Hash(0),_Score(1),_MinWeight(MinW),
+    _MaxWeight(MaxW),_MinDontCare(MinD),_MaxDontCare(MaxD){
+    _adjust(_MinWeight,_MaxWeight);
+    _adjust(_MinDontCare,_MaxDontCare);
+    random(Size, MaxW, MinW, MaxD, MinD, false, Rng);
+}
 /**
  * The file-constructor, can be used, if the patterns should be read from a
  * given file.
@@ -91,7 +103,7 @@ patternset::patternset(unsigned Size, unsigned MinW, unsigned MaxW,
  * @param InputFile   String, containing the name for a file containing a
  *                          pattern set.
  */
-patternset::patternset(std::string InputFile):_Score(1),_MinWeight(std::numeric_limits<unsigned>::max()),_MaxWeight(0),
+patternset::patternset(std::string InputFile):_UsedKeys(0),_Hash(0),_Score(1),_MinWeight(std::numeric_limits<unsigned>::max()),_MaxWeight(0),
     _MinDontCare(std::numeric_limits<unsigned>::max()),_MaxDontCare(0){
     std::ifstream Input(InputFile);
     assert(Input.is_open());
@@ -109,18 +121,50 @@ patternset::patternset(std::string InputFile):_Score(1),_MinWeight(std::numeric_
 }
 
 
+/**
+ * Finds the first line of a pattern file, that holds a pattern longer than
+ * pattern::MaxLength; the file is read like by the file-constructor, such
+ * that long patterns are reported before the set is built.
+ *
+ * @param InputFile     The name of the input file containing the patterns.
+ *
+ * @return              The number of the line, starting at 1; 0 if all
+ *                          patterns can be stored or the file can not be
+ *                          opened.
+ */
+unsigned patternset::long_pattern_line(std::string InputFile){
+    std::ifstream Input(InputFile);
+    unsigned LineNo = 0;
+    while(Input.is_open() && !Input.eof()){
+        std::string Line;
+        std::getline(Input,Line);
+        LineNo++;
+        if(Line[0] != '#'){
+            for(auto & Str : _split(Line)){
+                if(Str.size() > pattern::MaxLength){
+                    return LineNo;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+
 /**
  * Pushes a pattern into the set of pattern and adjusts the
  * mini-/maximal values for weight and DC positions.
  *
  * @param Pat           The pattern pushed into the set of patterns; r-value.
  */
-void patternset::push_back(pattern & Pat){
+void patternset::push_back(const pattern & Pat){
     _MaxDontCare = std::max(_MaxDontCare, Pat.dontcare());
     _MinDontCare = std::min(_MinDontCare, Pat.dontcare());
     _MaxWeight = std::max(_MaxWeight, Pat.weight());
     _MinWeight = std::min(_MinWeight, Pat.weight());
     _PatternSet.push_back(Pat);
+    _insert_key(Pat.length(), Pat.key());
+    _Hash ^= _pattern_hash(_PatternSet.size()-1, Pat);
 }
 /**
  * Pushes a pattern into the set of pattern and adjusts the
@@ -229,15 +273,46 @@ void patternset::random(unsigned Size, unsigned MinWeight, unsigned MaxWeight,
  */
 void patternset::random(unsigned Size, unsigned MinWeight, unsigned MaxWeight,
     unsigned MinDontCare, unsigned MaxDontCare, bool Uniq){
+    random(Size, MinWeight, MaxWeight, MinDontCare, MaxDontCare, Uniq, rng::thread_stream());
+}
+/**
+ * Creates a random set with given, passed parameter, drawing the patterns
+ * from a passed random stream. The set takes the passed limits; its buffers
+ * are reused, so a set can be regenerated without allocations.
+ *
+ * @param Size          The number of patterns.
+ *
+ * @param MinWeight     The minimal weight for a pattern.
+ *
+ * @param MaxWeight     The maximal weight for a pattern.
+ *
+ * @param MinDontCare   The minimal number of don't care positions for patterns.
+ *
+ * @param MaxDontCare   The maximal number of don't care positions for patterns.
+ *
+ * @param Uniq          Boolean; true, if each pattern has to be a unique
+ *                          pattern.
+ *
+ * @param Rng           The random stream.
+ */
+void patternset::random(unsigned Size, unsigned MinWeight, unsigned MaxWeight,
+    unsigned MinDontCare, unsigned MaxDontCare, bool Uniq, rng & Rng){
     _PatternSet.clear();
+    _Keys.clear();
+    _UsedKeys = 0;
     if(Size == 0){
         std::cerr << "Illegal value for pattern number!\nSize has to be greater than 0!" << std::endl;
         std::exit(-1);
     }
     _adjust(MinWeight,MaxWeight);
     _adjust(MinDontCare,MaxDontCare);
+    _MinWeight = MinWeight;
+    _MaxWeight = MaxWeight;
+    _MinDontCare = MinDontCare;
+    _MaxDontCare = MaxDontCare;
     if(Size >= 2){
-        _PatternSet.push_back(pattern(MinWeight,MinDontCare));
+        _PatternSet.push_back(pattern(MinWeight,MinDontCare,Rng));
+        _insert_key(_PatternSet.back().length(), _PatternSet.back().key());
         double StepW = (MaxWeight - MinWeight + 1)/(double)(Size);
         double StepD = (MaxDontCare - MinDontCare + 1)/(double)(Size);
         double CurrentW = MinWeight + StepW;
@@ -245,15 +320,16 @@ void patternset::random(unsigned Size, unsigned MinWeight, unsigned MaxWeight,
         unsigned PatSize = 0;
         char TryCtr = 0;
         while(PatSize < Size-2){
-            pattern Pat((unsigned)CurrentW, (unsigned)CurrentD,(uint64_t)PatSize+1);
+            pattern Pat((unsigned)CurrentW, (unsigned)CurrentD, Rng);
             TryCtr = 0;
             while(Uniq == false && is_uniq(Pat) == false && TryCtr++ < 100){
-                Pat.random((unsigned)CurrentW, (unsigned)CurrentD);
+                Pat.random((unsigned)CurrentW, (unsigned)CurrentD, Rng);
             }
             CurrentW += StepW;
             CurrentD += StepD;
             if(TryCtr < 100){
                 _PatternSet.push_back(Pat);
+                _insert_key(Pat.length(), Pat.key());
                 PatSize++;
             }
             else if(TryCtr >= 100 && (unsigned)CurrentW >= MaxWeight && (unsigned)CurrentD >= MaxDontCare){
@@ -261,17 +337,20 @@ void patternset::random(unsigned Size, unsigned MinWeight, unsigned MaxWeight,
             }
         }
         TryCtr = 0;
-        pattern Pat = pattern(MaxWeight,MaxDontCare,_PatternSet.size());
+        pattern Pat = pattern(MaxWeight,MaxDontCare,Rng);
         while(Uniq == false && is_uniq(Pat) == false && TryCtr++ < 100){
-            Pat.random(MaxWeight,MaxDontCare);
+            Pat.random(MaxWeight,MaxDontCare,Rng);
         }
         if(TryCtr < 100){
             _PatternSet.push_back(Pat);
+            _insert_key(Pat.length(), Pat.key());
         }
     }
     else{
-        _PatternSet.push_back(pattern((MinWeight + MaxWeight)/2,(MinDontCare + MaxDontCare)/2));
+        _PatternSet.push_back(pattern((MinWeight + MaxWeight)/2,(MinDontCare + MaxDontCare)/2,Rng));
+        _insert_key(_PatternSet.back().length(), _PatternSet.back().key());
     }
+    _rehash();
 }
 
 /**
@@ -279,18 +358,41 @@ void patternset::random(unsigned Size, unsigned MinWeight, unsigned MaxWeight,
  */
 void patternset::sort(){
     std::sort(_PatternSet.begin(), _PatternSet.end());
+    _rehash();
+}
+/**
+ * Removes all patterns of the set; the limits of weight and don't care
+ * positions are kept and the buffers are reused.
+ */
+void patternset::clear(){
+    _PatternSet.clear();
+    _Keys.clear();
+    _UsedKeys = 0;
+    _Hash = 0;
 }
 
 /**
  * Checks, if a pattern is pairwise unique with all patterns occuring
  * in the set. If the pattern is part of the set, the identical comparison
- * is ignored.
+ * is ignored. The key table answers the check; only for long patterns with
+ * an already used key the patterns are compared.
  *
  * @param Pat           The pattern that is compared to the set
  *
  * @return              Returns if this pattern is unique to the set.
  */
 bool patternset::is_uniq(const pattern & Pat) const{
+    unsigned Count = _count_key(Pat.length(), Pat.key());
+    std::less<const pattern *> Before;
+    if(!_PatternSet.empty() && !Before(&Pat, _PatternSet.data()) && Before(&Pat, _PatternSet.data()+_PatternSet.size())){
+        Count--;
+    }
+    if(Count == 0){
+        return true;
+    }
+    if(Pat.length() < 64){
+        return false;
+    }
     return (std::find_if(_PatternSet.begin(),_PatternSet.end(), [& Pat](const pattern & P){
         if( & Pat != & P){
             return (Pat == P);
@@ -298,6 +400,66 @@ bool patternset::is_uniq(const pattern & Pat) const{
         return false;
     }) == _PatternSet.end());
 }
+/**
+ * Checks, if a pattern of the set would still be unique after swapping two
+ * of its positions, without copying or changing the pattern.
+ *
+ * @param Idx           The index of the pattern in the set.
+ *
+ * @param PosA          The first position of the swap.
+ *
+ * @param PosB          The second position of the swap.
+ *
+ * @return              Returns if the swapped pattern is unique to the set.
+ */
+bool patternset::is_uniq_swap(unsigned Idx, unsigned PosA, unsigned PosB) const{
+    const pattern & Pat = _PatternSet[Idx];
+    uint64_t Key = Pat.swap_key(PosA, PosB);
+    if(_count_key(Pat.length(), Key) == 0){
+        return true;
+    }
+    if(Pat.length() < 64 && Key != Pat.key()){
+        return false;
+    }
+    pattern Swapped = Pat;
+    Swapped.bit_swap(PosA, PosB);
+    for(unsigned i = 0; i < _PatternSet.size(); i++){
+        if(i != Idx && _PatternSet[i] == Swapped){
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Replaces a pattern of the set and updates the key table.
+ *
+ * @param Idx           The index of the pattern in the set.
+ *
+ * @param Pat           The new pattern.
+ */
+void patternset::set(unsigned Idx, const pattern & Pat){
+    _erase_key(_PatternSet[Idx].length(), _PatternSet[Idx].key());
+    _Hash ^= _pattern_hash(Idx, _PatternSet[Idx]) ^ _pattern_hash(Idx, Pat);
+    _PatternSet[Idx] = Pat;
+    _insert_key(Pat.length(), Pat.key());
+}
+/**
+ * Swaps two positions of a pattern of the set and updates the key table.
+ *
+ * @param Idx           The index of the pattern in the set.
+ *
+ * @param PosA          The first position of the swap.
+ *
+ * @param PosB          The second position of the swap.
+ */
+void patternset::bit_swap(unsigned Idx, unsigned PosA, unsigned PosB){
+    pattern & Pat = _PatternSet[Idx];
+    _erase_key(Pat.length(), Pat.key());
+    _Hash = swap_hash(Idx, PosA, PosB);
+    Pat.bit_swap(PosA, PosB);
+    _insert_key(Pat.length(), Pat.key());
+}
 
 /**
  * Performs a random swap on a pattern an checks, if the resulting pattern
@@ -307,14 +469,54 @@ bool patternset::is_uniq(const pattern & Pat) const{
  *                          swapped randomly.
  */
 void patternset::random_swap_uniq(unsigned Idx){
-    pattern PatSave = _PatternSet[Idx];
+    unsigned MatchPos, DCPos;
+    random_swap_uniq(Idx, MatchPos, DCPos);
+}
+/**
+ * Performs a random swap on a pattern an checks, if the resulting pattern
+ * is unique in the set; accepts swap if unique. The swapped positions are
+ * returned. Each proposal is checked against the key table before the
+ * pattern is changed, so rejected proposals neither copy nor undo a pattern;
+ * the positions are drawn from the stream of the calling thread.
+ *
+ * @param Idx           The index of the pattern in the set that should be
+ *                          swapped randomly.
+ *
+ * @param MatchPos      Returns the former match position, now a don't care.
+ *
+ * @param DCPos         Returns the former don't care position, now a match.
+ *
+ * @return              True, if the pattern was changed.
+ */
+bool patternset::random_swap_uniq(unsigned Idx, unsigned & MatchPos, unsigned & DCPos){
+    return random_swap_uniq(Idx, MatchPos, DCPos, rng::thread_stream());
+}
+/**
+ * Performs a random swap on a pattern, as random_swap_uniq(), drawing the
+ * proposals from a passed random stream.
+ *
+ * @param Idx           The index of the pattern in the set that should be
+ *                          swapped randomly.
+ *
+ * @param MatchPos      Returns the former match position, now a don't care.
+ *
+ * @param DCPos         Returns the former don't care position, now a match.
+ *
+ * @param Rng           The random stream.
+ *
+ * @return              True, if the pattern was changed.
+ */
+bool patternset::random_swap_uniq(unsigned Idx, unsigned & MatchPos, unsigned & DCPos, rng & Rng){
     for(unsigned i = 0; i < (size()+10)*(size()+10); i++){
-        _PatternSet[Idx].random_swap();
-        if(is_uniq(_PatternSet[Idx]) == true){
-            return;
+        if(!_PatternSet[Idx].random_positions(Rng, MatchPos, DCPos)){
+            return false;
+        }
+        if(is_uniq_swap(Idx, MatchPos, DCPos)){
+            bit_swap(Idx, MatchPos, DCPos);
+            return true;
         }
-        _PatternSet[Idx] = PatSave;
     }
+    return false;
 }
 
 /**
@@ -332,28 +534,6 @@ void patternset::to_file(std::string OutFile){
 }
 
 
-/**
- * Random access operator, that returns the pattern from a specific
- * position in the set.
- *
- * @param Idx           The index number of a pattern, that sould be returned.
- *
- * @return              The pattern from the Idx-th position; constant
- */
-pattern patternset::operator[](size_t Idx) const{
-    return _PatternSet[Idx];
-}
-/**
- * Random access operator, that returns the pattern from a specific
- * position in the set.
- *
- * @param Idx           The index number of a pattern, that sould be returned.
- *
- * @return              The pattern from the Idx-th position; r-value
- */
-pattern & patternset::operator[](size_t Idx){
-    return _PatternSet[Idx];
-}
 
 /**
  * Compares the score of the pattern set with another set and returns true,
@@ -493,6 +673,56 @@ double patternset::score() const{
 void patternset::set_score(double Score){
     _Score = Score;
 }
+/**
+ * Stores a score for a single pattern of the set; the score is not part of
+ * the key table or the hash.
+ *
+ * @param Idx           The index of the pattern in the set.
+ *
+ * @param Score         Double value, saved to the pattern.
+ */
+void patternset::set_score(unsigned Idx, double Score){
+    _PatternSet[Idx].set_score(Score);
+}
+/**
+ * Stores an index for a single pattern of the set; the index is not part of
+ * the key table or the hash.
+ *
+ * @param Idx           The index of the pattern in the set.
+ *
+ * @param PatIdx        Index value, saved to the pattern.
+ */
+void patternset::set_idx(unsigned Idx, unsigned PatIdx){
+    _PatternSet[Idx].set_idx(PatIdx);
+}
+/**
+ * The Zobrist hash of the set; equal sets have the same hash, different sets
+ * have the same hash only by chance.
+ *
+ * @return              The hash of the set.
+ */
+uint64_t patternset::hash() const{
+    return _Hash;
+}
+/**
+ * The Zobrist hash, the set would have after swapping two positions of a
+ * pattern; only the keys of the two positions change.
+ *
+ * @param Idx           The index of the pattern in the set.
+ *
+ * @param PosA          The first position of the swap.
+ *
+ * @param PosB          The second position of the swap.
+ *
+ * @return              The hash of the swapped set.
+ */
+uint64_t patternset::swap_hash(unsigned Idx, unsigned PosA, unsigned PosB) const{
+    const pattern & Pat = _PatternSet[Idx];
+    if(Pat.is_match(PosA) == Pat.is_match(PosB)){
+        return _Hash;
+    }
+    return _Hash ^ _zobrist(Idx, PosA) ^ _zobrist(Idx, PosB);
+}
 
 
 /**
@@ -500,7 +730,7 @@ void patternset::set_score(double Score){
  *
  * @return              The begin iterator of the pattern set vector.
  */
-patternset::iterator patternset::begin(){
+patternset::const_iterator patternset::begin() const{
     return _PatternSet.begin();
 }
 /**
@@ -508,11 +738,145 @@ patternset::iterator patternset::begin(){
  *
  * @return              The end iterator of the pattern set vector.
  */
-patternset::iterator patternset::end(){
+patternset::const_iterator patternset::end() const{
     return _PatternSet.end();
 }
 
 
+/**
+ * Finds the slot of a key in the key table by linear probing; returns the
+ * slot of the key or the empty slot, where it would be inserted.
+ *
+ * @param Length        The length of the pattern.
+ *
+ * @param Key           The key of the pattern.
+ *
+ * @return              The slot index.
+ */
+size_t patternset::_find_key(unsigned Length, uint64_t Key) const{
+    size_t Mask = _Keys.size()-1;
+    uint64_t Hash = (Key ^ ((uint64_t)Length << 52))*0x9e3779b97f4a7c15ULL;
+    size_t Slot = (Hash ^ (Hash >> 32)) & Mask;
+    while(_Keys[Slot].Length != 0 && (_Keys[Slot].Length != Length || _Keys[Slot].Key != Key)){
+        Slot = (Slot+1) & Mask;
+    }
+    return Slot;
+}
+/**
+ * Returns the number of patterns in the set with the passed key.
+ *
+ * @param Length        The length of the pattern.
+ *
+ * @param Key           The key of the pattern.
+ *
+ * @return              The number of patterns with this key.
+ */
+unsigned patternset::_count_key(unsigned Length, uint64_t Key) const{
+    if(_Keys.empty()){
+        return 0;
+    }
+    return _Keys[_find_key(Length, Key)].Count;
+}
+/**
+ * Adds a pattern key to the key table; the table is rebuilt, if more than
+ * half of the slots are occupied.
+ *
+ * @param Length        The length of the pattern.
+ *
+ * @param Key           The key of the pattern.
+ */
+void patternset::_insert_key(unsigned Length, uint64_t Key){
+    if(2*(_UsedKeys+1) > _Keys.size()){
+        _rebuild_keys();
+    }
+    _key_slot & Slot = _Keys[_find_key(Length, Key)];
+    if(Slot.Length == 0){
+        Slot.Key = Key;
+        Slot.Length = Length;
+        Slot.Count = 0;
+        _UsedKeys++;
+    }
+    Slot.Count++;
+}
+/**
+ * Removes a pattern key from the key table; the slot stays occupied until
+ * the next rebuild, so probing sequences are not broken.
+ *
+ * @param Length        The length of the pattern.
+ *
+ * @param Key           The key of the pattern.
+ */
+void patternset::_erase_key(unsigned Length, uint64_t Key){
+    _key_slot & Slot = _Keys[_find_key(Length, Key)];
+    assert(Slot.Length != 0 && Slot.Count > 0);
+    Slot.Count--;
+}
+/**
+ * Rebuilds the key table from all keys still in use; the table gets at least
+ * four slots per key, so it is rebuilt only after many pattern changes.
+ */
+void patternset::_rebuild_keys(){
+    static thread_local std::vector<_key_slot> Live;
+    Live.clear();
+    for(const _key_slot & Slot : _Keys){
+        if(Slot.Length != 0 && Slot.Count > 0){
+            Live.push_back(Slot);
+        }
+    }
+    size_t Capacity = 16;
+    while(Capacity < 4*(Live.size()+1)){
+        Capacity *= 2;
+    }
+    _Keys.assign(Capacity, _key_slot{0, 0, 0});
+    for(const _key_slot & Slot : Live){
+        _Keys[_find_key(Slot.Length, Slot.Key)] = Slot;
+    }
+    _UsedKeys = Live.size();
+}
+
+/**
+ * The Zobrist key of a match position of a pattern. The keys are not stored
+ * in a table, but mixed from the index and the position by splitmix64, so
+ * that sets of any size and length have keys.
+ *
+ * @param Idx           The index of the pattern in the set.
+ *
+ * @param Pos           The match position.
+ *
+ * @return              The key.
+ */
+uint64_t patternset::_zobrist(unsigned Idx, unsigned Pos){
+    uint64_t Z = (((uint64_t)Idx << 32) | Pos) + 0x9e3779b97f4a7c15ULL;
+    Z = (Z ^ (Z >> 30))*0xbf58476d1ce4e5b9ULL;
+    Z = (Z ^ (Z >> 27))*0x94d049bb133111ebULL;
+    return Z ^ (Z >> 31);
+}
+/**
+ * The part of the Zobrist hash, that a pattern at an index contributes.
+ *
+ * @param Idx           The index of the pattern in the set.
+ *
+ * @param Pat           The pattern.
+ *
+ * @return              The XOR of the keys of all match positions.
+ */
+uint64_t patternset::_pattern_hash(unsigned Idx, const pattern & Pat){
+    uint64_t Hash = 0;
+    for(unsigned Pos : Pat.match_pos()){
+        Hash ^= _zobrist(Idx, Pos);
+    }
+    return Hash;
+}
+/**
+ * Computes the Zobrist hash of the set from scratch.
+ */
+void patternset::_rehash(){
+    _Hash = 0;
+    for(unsigned i = 0; i < _PatternSet.size(); i++){
+        _Hash ^= _pattern_hash(i, _PatternSet[i]);
+    }
+}
+
 /**
  * Function that is used to parse patterns from a file/string.
  * 
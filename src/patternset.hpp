@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <functional>
 #include <limits>
 #include <iostream>
 #include <fstream>
@@ -40,16 +41,31 @@
  *
  * In addition, only important pattern set parameters can be passed and a random
  * pattern set will be created.
+ *
+ * The keys of all patterns are held in an open addressing hash table, so that
+ * uniqueness checks do not compare against every pattern. Patterns should be
+ * changed by set() or bit_swap(); changing the positions of a pattern by
+ * reference bypasses the table.
+ *
+ * The whole set is identified by a Zobrist hash, the XOR of one key per
+ * match position of each pattern and its index; it is updated with each
+ * change of a pattern, and can be computed for a swap before the swap.
  */
 class patternset{
     public:
         patternset();
-        patternset(const patternset & PatSet);
+        patternset(const patternset & PatSet) = default;
+        patternset(patternset && PatSet) = default;
+        patternset & operator=(const patternset & PatSet) = default;
+        patternset & operator=(patternset && PatSet) = default;
         patternset(unsigned Size, unsigned Weight, unsigned DontCare, bool Uniq = false);
         patternset(unsigned Size, unsigned MinW, unsigned MaxW, unsigned MinDc, unsigned MaxDc, bool Uniq = false);
+        patternset(unsigned Size, unsigned MinW, unsigned MaxW, unsigned MinDc, unsigned MaxDc, bool Uniq, rng & Rng);
         patternset(std::string InputFile);
 
-        void push_back(pattern & Pat);
+        static unsigned long_pattern_line(std::string InputFile);
+
+        void push_back(const pattern & Pat);
         void push_back(pattern && Pat);
         void push_back(std::string & Pat);
         void push_back(std::string && Pat);
@@ -58,13 +74,19 @@ class patternset{
         void random(unsigned Size, unsigned Length, unsigned Weight, bool Uniq = false);
         void random(unsigned Size, unsigned MinLength, unsigned MaxLength, unsigned Weight, bool Uniq = false);
         void random(unsigned Size, unsigned MinLength, unsigned MaxLength, unsigned MinWeight, unsigned MaxWeight, bool Uniq = false);
+        void random(unsigned Size, unsigned MinLength, unsigned MaxLength, unsigned MinWeight, unsigned MaxWeight, bool Uniq, rng & Rng);
         void sort();
+        void clear();
         bool is_uniq(const pattern & Pat) const;
+        bool is_uniq_swap(unsigned Idx, unsigned PosA, unsigned PosB) const;
+        void set(unsigned Idx, const pattern & Pat);
+        void bit_swap(unsigned Idx, unsigned PosA, unsigned PosB);
         void random_swap_uniq(unsigned Idx);
+        bool random_swap_uniq(unsigned Idx, unsigned & MatchPos, unsigned & DCPos);
+        bool random_swap_uniq(unsigned Idx, unsigned & MatchPos, unsigned & DCPos, rng & Rng);
         void to_file(std::string OutFile = "patternset.pat");
 
-        pattern operator[](size_t Idx) const;
-        pattern & operator[](size_t Idx);
+        const pattern & operator[](size_t Idx) const;
         bool operator<(const patternset & P) const;
         bool operator>(const patternset & P) const;
 
@@ -81,23 +103,60 @@ class patternset{
 
         double score() const;
         void set_score(double Score);
+        void set_score(unsigned Idx, double Score);
+        void set_idx(unsigned Idx, unsigned PatIdx);
+        uint64_t hash() const;
+        uint64_t swap_hash(unsigned Idx, unsigned PosA, unsigned PosB) const;
 
 
-        typedef std::vector<pattern>::iterator iterator;
-        iterator begin();
-        iterator end();
+        typedef std::vector<pattern>::const_iterator const_iterator;
+        const_iterator begin() const;
+        const_iterator end() const;
 
     private:
+        /**
+         * A slot of the key table; a length of 0 marks an empty slot. Slots,
+         * whose count dropped to 0, stay occupied until the next rebuild.
+         */
+        struct _key_slot{
+            uint64_t Key;
+            unsigned Length;
+            unsigned Count;
+        };
         template<typename T>
         void _adjust(T & MinValue, T & MaxValue);
-        std::vector<std::string> _split(std::string &S);
+        static std::vector<std::string> _split(std::string &S);
+        size_t _find_key(unsigned Length, uint64_t Key) const;
+        unsigned _count_key(unsigned Length, uint64_t Key) const;
+        void _insert_key(unsigned Length, uint64_t Key);
+        void _erase_key(unsigned Length, uint64_t Key);
+        void _rebuild_keys();
+        static uint64_t _zobrist(unsigned Idx, unsigned Pos);
+        static uint64_t _pattern_hash(unsigned Idx, const pattern & Pat);
+        void _rehash();
         std::vector<pattern> _PatternSet;
+        std::vector<_key_slot> _Keys;
+        size_t _UsedKeys;
+        uint64_t _Hash;
         double _Score;
         unsigned _MinWeight;
         unsigned _MaxWeight;
         unsigned _MinDontCare;
         unsigned _MaxDontCare;
 };
+/**
+ * Random access operator, that returns the pattern from a specific
+ * position in the set.
+ *
+ * @param Idx           The index number of a pattern, that sould be returned.
+ *
+ * @return              The pattern from the Idx-th position; constant, such
+ *                          that the key table and the hash stay in sync. Use
+ *                          set() or bit_swap() to change a pattern.
+ */
+inline const pattern & patternset::operator[](size_t Idx) const{
+    return _PatternSet[Idx];
+}
 template<typename T>
 void patternset::_adjust(T & MinValue, T & MaxValue){
     if(MaxValue < MinValue){
@@ -21,97 +21,123 @@
 #include "rasbcomp.hpp"
 
 /**
- * Variable, used for sensitivity calculation. If there is a hugh memory usage
- * and the users wishes to continue, there wont be any question about the
- * memory usage in this run.
- */
-bool rasbhari_compute::DoOnce = false;
-
-/**
- * Calculates for a pair of pattern the variance Var(N). Here it is Pat1 != Pat2
- * and it is 2*Weight-Overlap = n(P1,P2,s). For theory, please have a look at 
- * rasbhari, L. Hahn et al.
+ * The default-constructor of the variance table; all powers for the passed
+ * parameters are computed once.
  *
- * @param Pat1          The first (upper) pattern.
+ * @param P             Match probability for homologous positions.
  *
- * @param Pat2          The second pattern, which is shifted.
+ * @param Q             Background match probability.
  *
- * @return              The pairwise value of Var(N)
+ * @param SeqLength     Sequence length of the dataset.
+ *
+ * @param Weight        The pattern weight.
  */
-double rasbhari_compute::pair_coef_var(pattern & Pat1, pattern & Pat2){
-    double CoEf = 0;
-    double LengthMean = (Pat1.length() + 1 + Pat2.length()) / 2;
-    for(int s = -(int)Pat2.length()+1; s < (int)Pat1.length(); s++){
-        unsigned Overlap = Pat1.get_overlap(Pat2,s);
-        CoEf += (rasb_opt::SeqLength - LengthMean + 1)*(pow(rasb_opt::P, 2*rasb_opt::Weight-Overlap) - pow(rasb_opt::P, 2 * rasb_opt::Weight))+(rasb_opt::SeqLength - LengthMean + 1)*(rasb_opt::SeqLength - LengthMean)*(pow(rasb_opt::Q, 2*rasb_opt::Weight-Overlap) - pow(rasb_opt::Q, 2 * rasb_opt::Weight));
+rasbhari_compute::var_table::var_table(double P, double Q, unsigned SeqLength, unsigned Weight):
+    P(P), Q(Q), SeqLength(SeqLength), Weight(Weight){
+    PowP = std::vector<double>(2*Weight+1);
+    PowQ = std::vector<double>(2*Weight+1);
+    for(unsigned k = 0; k <= 2*Weight; k++){
+        PowP[k] = pow(P, 2*Weight-k) - pow(P, 2*Weight);
+        PowQ[k] = pow(Q, 2*Weight-k) - pow(Q, 2*Weight);
     }
-    return CoEf;
 }
 /**
- * Calculates for a pair of pattern the variance Var(N). Here it is Pat1 == Pat2
- * and it is 2*Weight-Overlap = n(P1,P2,s). For theory, please have a look at 
- * rasbhari, L. Hahn et al.
+ * Checks, if the table was built for the passed parameters.
+ *
+ * @return              True, if the table can be used for these parameters.
+ */
+bool rasbhari_compute::var_table::matches(double P, double Q, unsigned SeqLength, unsigned Weight) const{
+    return this->P == P && this->Q == Q && this->SeqLength == SeqLength && this->Weight == Weight;
+}
+/**
+ * Computes the factors of a pattern pair, that depend on the pattern lengths
+ * only; these are multiplied to the power differences of each shift.
+ *
+ * @param Length1       The length of the first pattern.
+ *
+ * @param Length2       The length of the second pattern.
+ *
+ * @param FacP          Returns the factor for the homologous part.
  *
- * @param Pat1          The first (upper) pattern.
+ * @param FacQ          Returns the factor for the background part.
+ */
+void rasbhari_compute::var_table::length_factors(unsigned Length1, unsigned Length2, double & FacP, double & FacQ) const{
+    double LengthMean = (Length1 + 1 + Length2) / 2;
+    FacP = SeqLength - LengthMean + 1;
+    FacQ = (SeqLength - LengthMean + 1)*(SeqLength - LengthMean);
+}
+
+/**
+ * The default-constructor of the weighted OC table; all powers of the base
+ * up to the weight are computed once.
  *
- * @param Pat2          The second pattern, which is shifted.
+ * @param Base          The contribution factor of a single overlapping match.
  *
- * @return              The pairwise value of Var(N)
+ * @param Weight        The pattern weight.
  */
-double rasbhari_compute::pair_coef_var_sym(pattern & Pat1, pattern & Pat2){
-    double CoEf = 0;
-    double LengthMean = (Pat1.length() + 1 + Pat2.length()) / 2;
-    for(int s = 0; s < (int)Pat1.length(); s++){
-        unsigned Overlap = Pat1.get_overlap(Pat2,s);
-        CoEf += (rasb_opt::SeqLength - LengthMean + 1)*(pow(rasb_opt::P, 2*rasb_opt::Weight-Overlap) - pow(rasb_opt::P, 2 * rasb_opt::Weight))+(rasb_opt::SeqLength - LengthMean + 1)*(rasb_opt::SeqLength - LengthMean)*(pow(rasb_opt::Q, 2*rasb_opt::Weight-Overlap) - pow(rasb_opt::Q, 2 * rasb_opt::Weight));
+rasbhari_compute::woc_table::woc_table(double Base, unsigned Weight): Base(Base), Weight(Weight){
+    Pow = std::vector<double>(Weight+1);
+    for(unsigned k = 0; k <= Weight; k++){
+        Pow[k] = pow(Base, k);
     }
-    return CoEf;
+}
+/**
+ * Checks, if the table was built for the passed parameters.
+ *
+ * @return              True, if the table can be used for these parameters.
+ */
+bool rasbhari_compute::woc_table::matches(double Base, unsigned Weight) const{
+    return this->Base == Base && this->Weight == Weight;
 }
 
 /**
- * Calculates for a pair of pattern the overlap complexity.
- * For theory, please have a look at rasbhari, L. Hahn et al.
+ * Checks, if a sum of overlap complexity contributions is held by oc_int;
+ * each of the Shifts-many contributions is at most 2^Weight.
  *
- * @param Pat1          The first (upper) pattern.
+ * @param Weight        The largest overlap, i.e. the maximal pattern weight.
  *
- * @param Pat2          The second pattern, which is shifted.
+ * @param Shifts        The number of summed shifts of all pattern pairs.
  *
- * @return              The pairwise value of Var(N)
+ * @return              True, if the sum can not overflow.
  */
-double rasbhari_compute::pair_coef_oc(pattern & Pat1, pattern & Pat2){
-    double CoEf = 0;
-    for(int s = -(int)Pat2.length()+1; s < (int)Pat1.length(); s++){
-        CoEf += (uint64_t)1 << Pat1.get_overlap(Pat2,s);
+bool rasbhari_compute::oc_exact(unsigned Weight, uint64_t Shifts){
+    unsigned Bits = 0;
+    while(Bits < 64 && ((uint64_t)1 << Bits) < Shifts){
+        Bits++;
     }
-    return (double) CoEf;
+    return Weight + Bits < 127;
 }
 
-
 /**
  * Interface function to create the right pattern format for the speed functions.
  *
  * @param Pattern       Contains the patternset, for which the sensitivity
  *                          has to be calculated.
  *
+ * @param Config        The configuration of the run.
+ *
+ * @param State         The state of the run; the sensitivity is turned off,
+ *                          if it can not be computed.
+ *
  * @return              Sensitivity of the patterset.
  */
-double rasbhari_compute::sensitivity(patternset & Pattern){
+double rasbhari_compute::sensitivity(patternset & Pattern, const rasb_opt::config & Config, rasb_opt::run_state & State){
     if(Pattern.max_weight() > 63){
         sensitivity_memory::security_message("bitmode");
-        rasb_opt::Sens = false;
-        rasb_opt::OptSens = 1;
-        if(rasb_opt::OptOc > 1){
-            rasb_opt::ImproveMode = 2;
+        State.Sens = false;
+        State.OptSens = 1;
+        if(Config.OptOc > 1){
+            State.ImproveMode = 2;
         }
         else{
-            rasb_opt::ImproveMode = 1;
+            State.ImproveMode = 1;
         }
         return -1;
     }
     std::vector<char> Clean;
     double SensVal = -1;
     unsigned PSize = Pattern.size();
-    if(!DoOnce){
+    if(!State.SensPrinted){
         std::cout << "\rCalculating sensitivity ...";
         std::cout.flush();
     }
@@ -134,23 +160,23 @@ double rasbhari_compute::sensitivity(patternset & Pattern){
         Pats[i][Length] = '\0';
     }
     try{
-        SensVal = speedsens::MULTIPLE_SENSITIVITY2(Pats, rasb_opt::Size, rasb_opt::H, rasb_opt::P);
-        if(!DoOnce){
+        SensVal = speedsens::MULTIPLE_SENSITIVITY2(Pats, PSize, Config.H, Config.P, State);
+        if(!State.SensPrinted){
             std::cout << "\r" << std::string(80,' ') << "\r";
             std::cout.flush();
-            DoOnce = true;
+            State.SensPrinted = true;
         }
     }
     catch(std::bad_alloc){
-        if(!DoOnce){
+        if(!State.SensPrinted){
             std::cout << "\r" << std::string(80,' ') << "\r";
             std::cout.flush();
-            DoOnce = true;
+            State.SensPrinted = true;
         }
         std::cout << std::endl;
         sensitivity_memory::security_message("memerror");
-        rasb_opt::Sens = false;
-        rasb_opt::OptSens = 1;
+        State.Sens = false;
+        State.OptSens = 1;
         SensVal = -1;
     }
     return SensVal;
@@ -22,8 +22,11 @@
 #ifndef RASBCOMP_HPP_
 #define RASBCOMP_HPP_
 
+#include <cmath>
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <vector>
 #include "pattern.hpp"
 #include "patternset.hpp"
 #include "rasbopt.hpp"
@@ -38,10 +41,490 @@
  * by B. Morgenstern and L. Hahn. 
  */
 namespace rasbhari_compute{
-    double pair_coef_var(pattern & Pat1, pattern & Pat2);
-    double pair_coef_var_sym(pattern & Pat1, pattern & Pat2);
-    double pair_coef_oc(pattern & Pat1, pattern & Pat2);
-    double sensitivity(patternset & Pattern);
-    extern bool DoOnce;
+    /**
+     * Exact integer type for the overlap complexity. Each shift contributes
+     * 2^Overlap; if the sum of a set can exceed the type, see oc_exact(), the
+     * set is scored with doubles instead.
+     */
+    typedef __int128 oc_int;
+
+    /**
+     * The variance coefficient table is bound to the parameters P, Q, S and W.
+     * It holds the power differences P^(2W-k)-P^(2W) and Q^(2W-k)-Q^(2W) for
+     * every overlap k <= 2W, such that the variance of a pattern pair is
+     * computed by table lookups instead of calls to pow().
+     */
+    struct var_table{
+        var_table(double P, double Q, unsigned SeqLength, unsigned Weight);
+
+        bool matches(double P, double Q, unsigned SeqLength, unsigned Weight) const;
+        void length_factors(unsigned Length1, unsigned Length2, double & FacP, double & FacQ) const;
+        double term(unsigned Overlap, double FacP, double FacQ) const;
+
+        std::vector<double> PowP;
+        std::vector<double> PowQ;
+        double P;
+        double Q;
+        unsigned SeqLength;
+        unsigned Weight;
+    };
+
+    /**
+     * The power table of the weighted overlap complexity holds Base^k for
+     * every overlap k <= W.
+     */
+    struct woc_table{
+        woc_table(double Base, unsigned Weight);
+
+        bool matches(double Base, unsigned Weight) const;
+        double term(unsigned Overlap) const;
+
+        std::vector<double> Pow;
+        double Base;
+        unsigned Weight;
+    };
+
+    /**
+     * An objective policy is the interface between a score and the
+     * optimisation engines of the rasbhari class. A policy provides
+     *  - value_type, the coefficient type; oc_int for exact objectives,
+     *  - term(), the contribution of a single shift of a pattern pair,
+     *  - overlaps() and self_begin(), the overlaps and the first shift used
+     *    for a pattern with itself,
+     *  - pair() and self(), the full coefficients of a pair.
+     * The set score is the sum of all pair coefficients i <= j and the delta
+     * of a swap is computed by the engines from the shift contributions, thus
+     * every registered objective gets the incremental and parallel
+     * computations. The hill climbing is instantiated for each policy, the
+     * choice of the objective is done once and the pair kernels are inlined.
+     *
+     * Objective policy for the overlap complexity.
+     * The coefficients are exact integers, such that incremental updates do
+     * not drift and equal sets always have equal scores.
+     */
+    struct oc_objective{
+        typedef oc_int value_type;
+
+        /**
+         * The contribution of a single shift with a given overlap.
+         */
+        struct pair_term{
+            oc_int operator()(unsigned Overlap) const;
+        };
+        pair_term term(const pattern & Pat1, const pattern & Pat2) const;
+        void overlaps(const pattern & Pat1, const pattern & Pat2, std::vector<unsigned> & Overlaps) const;
+        unsigned self_begin(const pattern & Pat) const;
+        oc_int pair(const pattern & Pat1, const pattern & Pat2) const;
+        oc_int self(const pattern & Pat) const;
+    };
+    /**
+     * Objective policy for the variance. Pairs of distinct patterns use all
+     * shifts, the symmetric pair of a pattern with itself only the
+     * non-negative shifts.
+     */
+    struct var_objective{
+        typedef double value_type;
+
+        /**
+         * The contribution of a single shift with a given overlap; bound to
+         * the length factors of a pattern pair.
+         */
+        struct pair_term{
+            double operator()(unsigned Overlap) const;
+
+            const var_table * Table;
+            double FacP;
+            double FacQ;
+        };
+        var_objective(const var_table & Table);
+        pair_term term(const pattern & Pat1, const pattern & Pat2) const;
+        void overlaps(const pattern & Pat1, const pattern & Pat2, std::vector<unsigned> & Overlaps) const;
+        unsigned self_begin(const pattern & Pat) const;
+        double pair(const pattern & Pat1, const pattern & Pat2) const;
+        double self(const pattern & Pat) const;
+
+        const var_table & Table;
+    };
+    /**
+     * Objective policy for the weighted overlap complexity. A shift with
+     * overlap k contributes (1/p)^k instead of 2^k, i.e. it is weighted by
+     * the increase of the probability, that both spaced-word matches of the
+     * shift are homologous. Like the overlap complexity all shifts are used.
+     */
+    struct woc_objective{
+        typedef double value_type;
+
+        /**
+         * The contribution of a single shift with a given overlap.
+         */
+        struct pair_term{
+            double operator()(unsigned Overlap) const;
+
+            const woc_table * Table;
+        };
+        woc_objective(const woc_table & Table);
+        pair_term term(const pattern & Pat1, const pattern & Pat2) const;
+        void overlaps(const pattern & Pat1, const pattern & Pat2, std::vector<unsigned> & Overlaps) const;
+        unsigned self_begin(const pattern & Pat) const;
+        double pair(const pattern & Pat1, const pattern & Pat2) const;
+        double self(const pattern & Pat) const;
+
+        const woc_table & Table;
+    };
+    /**
+     * Objective policy for sets, whose patterns have at most 64*Words
+     * positions. The overlaps are computed by the unrolled fixed-length
+     * kernel of the pattern class, the shift contributions are taken from
+     * the wrapped policy. The length class is chosen once for a set from its
+     * maximal pattern length.
+     */
+    template<typename Objective, unsigned Words>
+    struct fixed_objective : public Objective{
+        fixed_objective(const Objective & Obj);
+        void overlaps(const pattern & Pat1, const pattern & Pat2, std::vector<unsigned> & Overlaps) const;
+        typename Objective::value_type pair(const pattern & Pat1, const pattern & Pat2) const;
+        typename Objective::value_type self(const pattern & Pat) const;
+    };
+
+    double sensitivity(patternset & Pattern, const rasb_opt::config & Config, rasb_opt::run_state & State);
+    bool oc_exact(unsigned Weight, uint64_t Shifts);
 };
+
+/**
+ * Returns for a pattern pair the variance contribution of a single shift
+ * with the passed overlap; the length factors have to be requested by
+ * length_factors() before.
+ *
+ * @param Overlap       The overlap of the pattern pair for the shift.
+ *
+ * @param FacP          The length factor for the homologous part.
+ *
+ * @param FacQ          The length factor for the background part.
+ *
+ * @return              The variance contribution of the shift.
+ */
+inline double rasbhari_compute::var_table::term(unsigned Overlap, double FacP, double FacQ) const{
+    if(Overlap < PowP.size()){
+        return FacP*PowP[Overlap] + FacQ*PowQ[Overlap];
+    }
+    return FacP*(pow(P, 2*Weight-Overlap) - pow(P, 2*Weight)) + FacQ*(pow(Q, 2*Weight-Overlap) - pow(Q, 2*Weight));
+}
+
+/**
+ * Returns the overlap complexity of a single shift, 2^Overlap.
+ *
+ * @param Overlap       The overlap of the pattern pair for the shift.
+ *
+ * @return              The contribution of the shift.
+ */
+inline rasbhari_compute::oc_int rasbhari_compute::oc_objective::pair_term::operator()(unsigned Overlap) const{
+    return (oc_int)1 << Overlap;
+}
+/**
+ * Returns the shift contribution function for a pattern pair.
+ *
+ * @return              The shift contribution of the overlap complexity.
+ */
+inline rasbhari_compute::oc_objective::pair_term rasbhari_compute::oc_objective::term(const pattern & Pat1, const pattern & Pat2) const{
+    return pair_term();
+}
+/**
+ * Computes the overlaps of a pattern pair for all shifts.
+ *
+ * @param Pat1          The first (upper) pattern.
+ *
+ * @param Pat2          The second pattern, which is shifted.
+ *
+ * @param Overlaps      Returns the overlap of every shift.
+ */
+inline void rasbhari_compute::oc_objective::overlaps(const pattern & Pat1, const pattern & Pat2, std::vector<unsigned> & Overlaps) const{
+    Pat1.get_overlaps(Pat2, Overlaps);
+}
+/**
+ * Returns the first overlap, that contributes to the coefficient of a
+ * pattern with itself; for the overlap complexity all shifts are used.
+ *
+ * @param Pat           The pattern.
+ *
+ * @return              The index of the first overlap.
+ */
+inline unsigned rasbhari_compute::oc_objective::self_begin(const pattern & Pat) const{
+    return 0;
+}
+/**
+ * Calculates for a pair of pattern the overlap complexity.
+ *
+ * @param Pat1          The first (upper) pattern.
+ *
+ * @param Pat2          The second pattern, which is shifted.
+ *
+ * @return              The pairwise overlap complexity.
+ */
+inline rasbhari_compute::oc_int rasbhari_compute::oc_objective::pair(const pattern & Pat1, const pattern & Pat2) const{
+    static thread_local std::vector<unsigned> Overlaps;
+    oc_int CoEf = 0;
+    Pat1.get_overlaps(Pat2, Overlaps);
+    for(unsigned Overlap : Overlaps){
+        CoEf += (oc_int)1 << Overlap;
+    }
+    return CoEf;
+}
+/**
+ * Calculates the overlap complexity of a pattern with itself.
+ *
+ * @param Pat           The pattern.
+ *
+ * @return              The overlap complexity of the pattern with itself.
+ */
+inline rasbhari_compute::oc_int rasbhari_compute::oc_objective::self(const pattern & Pat) const{
+    return pair(Pat, Pat);
+}
+
+/**
+ * Binds the variance policy to a variance table.
+ *
+ * @param Table         The variance table for the current parameters.
+ */
+inline rasbhari_compute::var_objective::var_objective(const var_table & Table): Table(Table){
+}
+/**
+ * Returns the variance of a single shift for the bound length factors.
+ *
+ * @param Overlap       The overlap of the pattern pair for the shift.
+ *
+ * @return              The contribution of the shift.
+ */
+inline double rasbhari_compute::var_objective::pair_term::operator()(unsigned Overlap) const{
+    return Table->term(Overlap, FacP, FacQ);
+}
+/**
+ * Returns the shift contribution function for a pattern pair, i.e. the
+ * variance table bound to the length factors of the pair.
+ *
+ * @param Pat1          The first (upper) pattern.
+ *
+ * @param Pat2          The second pattern, which is shifted.
+ *
+ * @return              The shift contribution of the variance.
+ */
+inline rasbhari_compute::var_objective::pair_term rasbhari_compute::var_objective::term(const pattern & Pat1, const pattern & Pat2) const{
+    pair_term Term;
+    Term.Table = &Table;
+    Table.length_factors(Pat1.length(), Pat2.length(), Term.FacP, Term.FacQ);
+    return Term;
+}
+/**
+ * Computes the overlaps of a pattern pair for all shifts.
+ *
+ * @param Pat1          The first (upper) pattern.
+ *
+ * @param Pat2          The second pattern, which is shifted.
+ *
+ * @param Overlaps      Returns the overlap of every shift.
+ */
+inline void rasbhari_compute::var_objective::overlaps(const pattern & Pat1, const pattern & Pat2, std::vector<unsigned> & Overlaps) const{
+    Pat1.get_overlaps(Pat2, Overlaps);
+}
+/**
+ * Returns the first overlap, that contributes to the variance of a pattern
+ * with itself, i.e. the overlap of shift 0.
+ *
+ * @param Pat           The pattern.
+ *
+ * @return              The index of the first overlap.
+ */
+inline unsigned rasbhari_compute::var_objective::self_begin(const pattern & Pat) const{
+    return Pat.length()-1;
+}
+/**
+ * Calculates for a pair of distinct pattern the variance Var(N).
+ *
+ * @param Pat1          The first (upper) pattern.
+ *
+ * @param Pat2          The second pattern, which is shifted.
+ *
+ * @return              The pairwise value of Var(N)
+ */
+inline double rasbhari_compute::var_objective::pair(const pattern & Pat1, const pattern & Pat2) const{
+    static thread_local std::vector<unsigned> Overlaps;
+    double CoEf = 0, FacP, FacQ;
+    Table.length_factors(Pat1.length(), Pat2.length(), FacP, FacQ);
+    Pat1.get_overlaps(Pat2, Overlaps);
+    for(unsigned Overlap : Overlaps){
+        CoEf += Table.term(Overlap, FacP, FacQ);
+    }
+    return CoEf;
+}
+/**
+ * Calculates for a pattern with itself the variance Var(N); only the
+ * non-negative shifts are considered.
+ *
+ * @param Pat           The pattern.
+ *
+ * @return              The symmetric value of Var(N)
+ */
+inline double rasbhari_compute::var_objective::self(const pattern & Pat) const{
+    static thread_local std::vector<unsigned> Overlaps;
+    double CoEf = 0, FacP, FacQ;
+    Table.length_factors(Pat.length(), Pat.length(), FacP, FacQ);
+    Pat.get_overlaps(Pat, Overlaps);
+    for(unsigned s = self_begin(Pat); s < Overlaps.size(); s++){
+        CoEf += Table.term(Overlaps[s], FacP, FacQ);
+    }
+    return CoEf;
+}
+
+/**
+ * Returns the weighted overlap complexity of a single shift, Base^Overlap.
+ *
+ * @param Overlap       The overlap of the pattern pair for the shift.
+ *
+ * @return              The contribution of the shift.
+ */
+inline double rasbhari_compute::woc_table::term(unsigned Overlap) const{
+    if(Overlap < Pow.size()){
+        return Pow[Overlap];
+    }
+    return pow(Base, Overlap);
+}
+/**
+ * Binds the weighted overlap complexity policy to a power table.
+ *
+ * @param Table         The power table for the current parameters.
+ */
+inline rasbhari_compute::woc_objective::woc_objective(const woc_table & Table): Table(Table){
+}
+/**
+ * Returns the weighted overlap complexity of a single shift.
+ *
+ * @param Overlap       The overlap of the pattern pair for the shift.
+ *
+ * @return              The contribution of the shift.
+ */
+inline double rasbhari_compute::woc_objective::pair_term::operator()(unsigned Overlap) const{
+    return Table->term(Overlap);
+}
+/**
+ * Returns the shift contribution function for a pattern pair.
+ *
+ * @return              The shift contribution of the weighted OC.
+ */
+inline rasbhari_compute::woc_objective::pair_term rasbhari_compute::woc_objective::term(const pattern & Pat1, const pattern & Pat2) const{
+    pair_term Term;
+    Term.Table = &Table;
+    return Term;
+}
+/**
+ * Computes the overlaps of a pattern pair for all shifts.
+ *
+ * @param Pat1          The first (upper) pattern.
+ *
+ * @param Pat2          The second pattern, which is shifted.
+ *
+ * @param Overlaps      Returns the overlap of every shift.
+ */
+inline void rasbhari_compute::woc_objective::overlaps(const pattern & Pat1, const pattern & Pat2, std::vector<unsigned> & Overlaps) const{
+    Pat1.get_overlaps(Pat2, Overlaps);
+}
+/**
+ * Returns the first overlap, that contributes to the coefficient of a
+ * pattern with itself; like for the overlap complexity all shifts are used.
+ *
+ * @param Pat           The pattern.
+ *
+ * @return              The index of the first overlap.
+ */
+inline unsigned rasbhari_compute::woc_objective::self_begin(const pattern & Pat) const{
+    return 0;
+}
+/**
+ * Calculates for a pair of pattern the weighted overlap complexity.
+ *
+ * @param Pat1          The first (upper) pattern.
+ *
+ * @param Pat2          The second pattern, which is shifted.
+ *
+ * @return              The pairwise weighted overlap complexity.
+ */
+inline double rasbhari_compute::woc_objective::pair(const pattern & Pat1, const pattern & Pat2) const{
+    static thread_local std::vector<unsigned> Overlaps;
+    double CoEf = 0;
+    Pat1.get_overlaps(Pat2, Overlaps);
+    for(unsigned Overlap : Overlaps){
+        CoEf += Table.term(Overlap);
+    }
+    return CoEf;
+}
+/**
+ * Calculates the weighted overlap complexity of a pattern with itself.
+ *
+ * @param Pat           The pattern.
+ *
+ * @return              The weighted overlap complexity of the pattern with itself.
+ */
+inline double rasbhari_compute::woc_objective::self(const pattern & Pat) const{
+    return pair(Pat, Pat);
+}
+
+/**
+ * Binds the fixed-length policy to an objective policy.
+ *
+ * @param Obj           The wrapped objective policy, OC or variance.
+ */
+template<typename Objective, unsigned Words>
+rasbhari_compute::fixed_objective<Objective,Words>::fixed_objective(const Objective & Obj): Objective(Obj){
+}
+/**
+ * Computes the overlaps of a pattern pair for all shifts by the fixed-length
+ * kernel.
+ *
+ * @param Pat1          The first (upper) pattern.
+ *
+ * @param Pat2          The second pattern, which is shifted.
+ *
+ * @param Overlaps      Returns the overlap of every shift.
+ */
+template<typename Objective, unsigned Words>
+void rasbhari_compute::fixed_objective<Objective,Words>::overlaps(const pattern & Pat1, const pattern & Pat2, std::vector<unsigned> & Overlaps) const{
+    Overlaps.resize(Pat1.length() + Pat2.length() - 1);
+    Pat1.get_fixed_overlaps<Words>(Pat2, Overlaps.data());
+}
+/**
+ * Calculates the coefficient of two distinct patterns.
+ *
+ * @param Pat1          The first (upper) pattern.
+ *
+ * @param Pat2          The second pattern, which is shifted.
+ *
+ * @return              The pairwise coefficient.
+ */
+template<typename Objective, unsigned Words>
+typename Objective::value_type rasbhari_compute::fixed_objective<Objective,Words>::pair(const pattern & Pat1, const pattern & Pat2) const{
+    static thread_local std::vector<unsigned> Overlaps;
+    typename Objective::value_type CoEf = 0;
+    typename Objective::pair_term Term = this->term(Pat1, Pat2);
+    overlaps(Pat1, Pat2, Overlaps);
+    for(unsigned Overlap : Overlaps){
+        CoEf += Term(Overlap);
+    }
+    return CoEf;
+}
+/**
+ * Calculates the coefficient of a pattern with itself.
+ *
+ * @param Pat           The pattern.
+ *
+ * @return              The symmetric coefficient.
+ */
+template<typename Objective, unsigned Words>
+typename Objective::value_type rasbhari_compute::fixed_objective<Objective,Words>::self(const pattern & Pat) const{
+    static thread_local std::vector<unsigned> Overlaps;
+    typename Objective::value_type CoEf = 0;
+    typename Objective::pair_term Term = this->term(Pat, Pat);
+    overlaps(Pat, Pat, Overlaps);
+    for(unsigned s = this->self_begin(Pat); s < Overlaps.size(); s++){
+        CoEf += Term(Overlaps[s]);
+    }
+    return CoEf;
+}
 #endif
\ No newline at end of file
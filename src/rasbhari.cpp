@@ -21,25 +21,89 @@
  */
 #include "rasbhari.hpp"
 
+namespace{
+    /**
+     * Upper bound for the number of stored overlaps of all pattern pairs of
+     * all instances, that run at once on several threads; for larger sets
+     * the overlap profiles are not used.
+     */
+    const size_t MaxProfileSize = (size_t)1 << 27;
+
+    /**
+     * Number of patterns per row and column of a tile of the coef_matrix.
+     */
+    const unsigned TileSize = 32;
+
+    /**
+     * Minimal number of patterns, for which the tiles of the coef_matrix are
+     * computed by several threads.
+     */
+    const unsigned ParallelSize = 64;
+
+    /**
+     * Number of random swaps, that are scored to calibrate the start
+     * temperature of the annealing engine.
+     */
+    const unsigned AnnealSample = 100;
+
+    /**
+     * Number of annealing steps of each replica of the tempering engine
+     * between two exchanges of the temperatures.
+     */
+    const unsigned ExchangeInterval = 500;
+
+    /**
+     * Upper bound for the number of slots of the table of scored sets of the
+     * tabu engine.
+     */
+    const size_t MaxVisited = (size_t)1 << 22;
+
+    /**
+     * Number of random patterns drawn by the crossover of the memetic
+     * restarts for a single index, before the restart starts from a random set.
+     */
+    const unsigned MaxCrossoverTries = 1000000;
+
+    /**
+     * Counts the set bits of a 64-bit word. Without a popcnt instruction the
+     * bit-parallel version is used, as it is inlined and vectorised in loops.
+     *
+     * @param X             The word.
+     *
+     * @return              The number of set bits.
+     */
+    inline unsigned popcount(uint64_t X){
+#ifdef __POPCNT__
+        return __builtin_popcountll(X);
+#else
+        X = X - ((X >> 1) & 0x5555555555555555ULL);
+        X = (X & 0x3333333333333333ULL) + ((X >> 2) & 0x3333333333333333ULL);
+        X = (X + (X >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        return (X * 0x0101010101010101ULL) >> 56;
+#endif
+    }
+
+    /**
+     * Shift contribution that is always zero; used, if overlap profiles are
+     * changed without scoring, e.g. when a swap is undone.
+     */
+    struct null_term{
+        double operator()(unsigned Overlap) const{
+            return 0;
+        }
+    };
+}
+
 /**
  * The empty-constructor, can be used, if patterns should be pushed into the
  * rasbhari instance for optimising.
- */
-rasbhari::rasbhari():_RasbhariScore(0),_RasbhariSensitivity(-1), _PatNo(0){
-}
-/**
- * The copy-constructor, can be used, if an already existing rasbhari instance
- * shall be copied.
  *
- * @param RasbObj       The rasbhari instance that should be copied.
+ * @param Config        The configuration of the run; the global options, if
+ *                          not passed.
  */
-rasbhari::rasbhari(const rasbhari &RasbObj){
-    _CoefMat = RasbObj._CoefMat;
-    _PatternList = RasbObj._PatternList;
-    _RasbhariPattern = RasbObj._RasbhariPattern;
-    _RasbhariScore = RasbObj._RasbhariScore;
-    _RasbhariSensitivity = RasbObj._RasbhariSensitivity;
-    _PatNo = RasbObj._PatNo;
+rasbhari::rasbhari(const rasb_opt::config & Config):_Config(Config),_State(Config),
+    _VarTable(Config.P,Config.Q,Config.SeqLength,Config.Weight),_WocTable(1/Config.P,Config.Weight),_OcTable(2,Config.Weight),_Rng(_make_rng(Config)),_RasbhariScore(0),_OcScore(0),
+    _RasbhariSensitivity(-1), _PatNo(0),_Threads(Config.Threads){
 }
 /**
  * The std-constructor-1, can be used, if patterns should be created randomly.
@@ -50,11 +114,20 @@ rasbhari::rasbhari(const rasbhari &RasbObj){
  * @param Weight        The number of match positions, i.e. the weight.
  *
  * @param DontCare      The number of don't-care positions
+ *
+ * @param Config        The configuration of the run; the global options, if
+ *                          not passed.
  */
-rasbhari::rasbhari(unsigned Size, unsigned Weight, unsigned DontCare):_RasbhariScore(0),_RasbhariSensitivity(-1), _PatNo(0){
+rasbhari::rasbhari(unsigned Size, unsigned Weight, unsigned DontCare, const rasb_opt::config & Config):_Config(Config),_State(Config),
+    _VarTable(Config.P,Config.Q,Config.SeqLength,Config.Weight),_WocTable(1/Config.P,Config.Weight),_OcTable(2,Config.Weight),_Rng(_make_rng(Config)),_RasbhariScore(0),_OcScore(0),
+    _RasbhariSensitivity(-1), _PatNo(0),_Threads(Config.Threads){
     _check_pattern_number(Size, Weight, DontCare, DontCare);
-    _RasbhariPattern = patternset(Size,Weight,DontCare,true);
-    _make_pattern_list();
+    _Config.Size = Size;
+    _Config.Weight = Weight;
+    _Config.MinDontcare = DontCare;
+    _Config.MaxDontcare = DontCare;
+    _RasbhariPattern = patternset(Size,Weight,Weight,DontCare,DontCare,true,_Rng);
+    _make_order();
     _adjust_coef_mat();
     calculate();
     calculate_sensitivity();
@@ -70,11 +143,20 @@ rasbhari::rasbhari(unsigned Size, unsigned Weight, unsigned DontCare):_RasbhariS
  * @param MinDontCare   The minimal number of don't-care positions
  *
  * @param MaxDontCare   The maximal number of don't-care positions
+ *
+ * @param Config        The configuration of the run; the global options, if
+ *                          not passed.
  */
-rasbhari::rasbhari(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare):_RasbhariScore(0),_RasbhariSensitivity(-1), _PatNo(0){\
+rasbhari::rasbhari(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare, const rasb_opt::config & Config):_Config(Config),_State(Config),
+    _VarTable(Config.P,Config.Q,Config.SeqLength,Config.Weight),_WocTable(1/Config.P,Config.Weight),_OcTable(2,Config.Weight),_Rng(_make_rng(Config)),_RasbhariScore(0),_OcScore(0),
+    _RasbhariSensitivity(-1), _PatNo(0),_Threads(Config.Threads){
     _check_pattern_number(Size, Weight, MinDontCare, MaxDontCare);
-    _RasbhariPattern = patternset(Size,Weight,Weight,MinDontCare,MaxDontCare,true);
-    _make_pattern_list();
+    _Config.Size = Size;
+    _Config.Weight = Weight;
+    _Config.MinDontcare = MinDontCare;
+    _Config.MaxDontcare = MaxDontCare;
+    _RasbhariPattern = patternset(Size,Weight,Weight,MinDontCare,MaxDontCare,true,_Rng);
+    _make_order();
     _adjust_coef_mat();
     calculate();
     calculate_sensitivity();
@@ -84,11 +166,22 @@ rasbhari::rasbhari(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigne
  * given file.
  *
  * @param PatternFile   String, containing the name for a file containing a
- *                          pattern set.
+ *                          pattern set; the size, weight and don't-care
+ *                          positions of the configuration are taken from
+ *                          the set.
+ *
+ * @param Config        The configuration of the run; the global options, if
+ *                          not passed.
  */
-rasbhari::rasbhari(std::string PatternFile):_RasbhariScore(0),_RasbhariSensitivity(-1), _PatNo(0){\
+rasbhari::rasbhari(std::string PatternFile, const rasb_opt::config & Config):_Config(Config),_State(Config),
+    _VarTable(Config.P,Config.Q,Config.SeqLength,Config.Weight),_WocTable(1/Config.P,Config.Weight),_OcTable(2,Config.Weight),_Rng(_make_rng(Config)),_RasbhariScore(0),_OcScore(0),
+    _RasbhariSensitivity(-1), _PatNo(0),_Threads(Config.Threads){
     _RasbhariPattern = patternset(PatternFile);
-    _make_pattern_list();
+    _Config.Size = _RasbhariPattern.size();
+    _Config.Weight = _RasbhariPattern.max_weight();
+    _Config.MinDontcare = _RasbhariPattern.min_dontcare();
+    _Config.MaxDontcare = _RasbhariPattern.max_dontcare();
+    _make_order();
     _adjust_coef_mat();
     calculate();
     calculate_sensitivity();
@@ -116,146 +209,1395 @@ void rasbhari::push_back(pattern & Pat){
     if(Pat.weight() != _RasbhariPattern.weight()){
         return;
     }
-    _PatternList.push_back(Pat);
-    _RasbhariPattern.push_back(Pat);
-    _RasbhariPattern[_RasbhariPattern.size()-1].set_idx(_RasbhariPattern.size()-1);
-    _PatternList[_PatternList.size()-1].set_idx(_PatternList.size()-1);
-    _adjust_coef_mat();
-    _RasbhariScore = -1;
-    _RasbhariSensitivity = -1;
-    rasb_opt::Size++;
-    rasb_opt::MinDontcare = std::min(Pat.dontcare(),_RasbhariPattern.min_dontcare());
-    rasb_opt::MaxDontcare = std::max(Pat.dontcare(),_RasbhariPattern.max_dontcare());
+    _RasbhariPattern.push_back(Pat);
+    _RasbhariPattern.set_idx(_RasbhariPattern.size()-1, _RasbhariPattern.size()-1);
+    _Order.push_back(_RasbhariPattern.size()-1);
+    _adjust_coef_mat();
+    _Profiles.clear();
+    _RasbhariScore = -1;
+    _OcScore = -1;
+    _RasbhariSensitivity = -1;
+    _Config.Size++;
+    _Config.MinDontcare = std::min(Pat.dontcare(),_RasbhariPattern.min_dontcare());
+    _Config.MaxDontcare = std::max(Pat.dontcare(),_RasbhariPattern.max_dontcare());
+}
+
+/**
+ * Since often needed a function that resets the coefficient matrix for oc/var.
+ * Only the matrix of the current objective is used, the other one is empty;
+ * the buffer of the used matrix is kept between restarts.
+ */
+void rasbhari::_adjust_coef_mat(){
+    if(_exact()){
+        _CoefMat.clear();
+        _OcMat.reset(_RasbhariPattern.size());
+    }
+    else{
+        _OcMat.clear();
+        _CoefMat.reset(_RasbhariPattern.size());
+    }
+}
+/**
+ * Returns the coefficient matrix of the variance.
+ */
+template<>
+coefmatrix<double> & rasbhari::_coef_mat<double>(){
+    return _CoefMat;
+}
+/**
+ * Returns the exact coefficient matrix of the overlap complexity.
+ */
+template<>
+coefmatrix<rasbhari_compute::oc_int> & rasbhari::_coef_mat<rasbhari_compute::oc_int>(){
+    return _OcMat;
+}
+/**
+ * Returns the score of the set for the variance.
+ */
+template<>
+double & rasbhari::_score<double>(){
+    return _RasbhariScore;
+}
+/**
+ * Returns the exact score of the set for the overlap complexity.
+ */
+template<>
+rasbhari_compute::oc_int & rasbhari::_score<rasbhari_compute::oc_int>(){
+    return _OcScore;
+}
+
+/**
+ * Calls of the policy based internals; each call is instantiated for every
+ * objective policy and length class by _dispatch().
+ */
+struct rasbhari::_calculate_call{
+    typedef void result_type;
+    template<typename Objective>
+    void operator()(rasbhari & Rasb, const Objective & Obj) const{
+        Rasb._calculate(Obj);
+    }
+};
+struct rasbhari::_update_call{
+    typedef void result_type;
+    template<typename Objective>
+    void operator()(rasbhari & Rasb, const Objective & Obj) const{
+        Rasb._update(Idx, Obj);
+    }
+    unsigned Idx;
+};
+struct rasbhari::_climb_hill_call{
+    typedef bool result_type;
+    template<typename Objective>
+    bool operator()(rasbhari & Rasb, const Objective & Obj) const{
+        return Rasb._climb_hill(Obj);
+    }
+};
+struct rasbhari::_climb_hill_steepest_call{
+    typedef bool result_type;
+    template<typename Objective>
+    bool operator()(rasbhari & Rasb, const Objective & Obj) const{
+        return Rasb._climb_hill_steepest(Obj);
+    }
+};
+struct rasbhari::_climb_hill_anneal_call{
+    typedef bool result_type;
+    template<typename Objective>
+    bool operator()(rasbhari & Rasb, const Objective & Obj) const{
+        return Rasb._climb_hill_anneal(Obj, Temperature);
+    }
+    double Temperature;
+};
+struct rasbhari::_hill_climbing_call{
+    typedef bool result_type;
+    template<typename Objective>
+    bool operator()(rasbhari & Rasb, const Objective & Obj) const{
+        return Rasb._hill_climbing(Limit, Obj);
+    }
+    unsigned Limit;
+};
+struct rasbhari::_pair_call{
+    typedef double result_type;
+    template<typename Objective>
+    double operator()(rasbhari & Rasb, const Objective & Obj) const{
+        if(Idx1 == Idx2){
+            return (double)Obj.self(Rasb._RasbhariPattern[Idx1]);
+        }
+        return (double)Obj.pair(Rasb._RasbhariPattern[Idx1], Rasb._RasbhariPattern[Idx2]);
+    }
+    size_t Idx1;
+    size_t Idx2;
+};
+struct rasbhari::_exact_call{
+    typedef bool result_type;
+    template<typename Objective>
+    bool operator()(rasbhari & Rasb, const Objective & Obj) const{
+        return std::is_same<typename Objective::value_type, rasbhari_compute::oc_int>::value;
+    }
+};
+/**
+ * The undo log of a single optimising step. An update of one pattern only
+ * changes its column of the coefficient matrix, the row sums, the pattern
+ * itself and the set score; only these are recorded before the step and
+ * restored, if the step is rejected. The buffers are reused by the
+ * following steps.
+ */
+template<typename Value>
+struct rasbhari::_undo_log{
+    void record(rasbhari & Rasb, unsigned Idx){
+        coefmatrix<Value> & CoefMat = Rasb._coef_mat<Value>();
+        unsigned Size = Rasb._RasbhariPattern.size();
+        Column.resize(Size);
+        RowSums.resize(Size);
+        for(unsigned i = 0; i < Size; i++){
+            Column[i] = CoefMat.get(i, Idx);
+            RowSums[i] = CoefMat.row_sum(i);
+        }
+        Pat = Rasb._RasbhariPattern[Idx];
+        Score = Rasb._score<Value>();
+        RasbhariScore = Rasb._RasbhariScore;
+        this->Idx = Idx;
+    }
+    void restore(rasbhari & Rasb) const{
+        coefmatrix<Value> & CoefMat = Rasb._coef_mat<Value>();
+        for(unsigned i = 0; i < Column.size(); i++){
+            CoefMat.assign(i, Idx, Column[i]);
+            CoefMat.row_sum(i) = RowSums[i];
+        }
+        Rasb._RasbhariPattern.set(Idx, Pat);
+        Rasb._score<Value>() = Score;
+        Rasb._RasbhariScore = RasbhariScore;
+    }
+
+    std::vector<Value> Column;
+    std::vector<Value> RowSums;
+    pattern Pat;
+    Value Score;
+    double RasbhariScore;
+    unsigned Idx;
+};
+/**
+ * The cooling schedule of the annealing engine over Length steps. The
+ * geometric schedule multiplies the temperature by a constant factor, such
+ * that it ends at 1/1000 of the start temperature; the linear schedule lowers
+ * it by a constant step down to 0. If no better set was found for Reheat
+ * steps in a row, the schedule starts again at the start temperature.
+ */
+struct rasbhari::_anneal_schedule{
+    _anneal_schedule(const rasb_opt::config & Config, double Start, unsigned Length):
+        Start(Start),Temperature(Start),Decrement(Length ? Start/Length : 0),
+        Factor(Length ? std::pow(1e-3, 1.0/Length) : 1),Reheat(Config.Reheat),Idle(0),
+        Geometric(Config.Cooling != "linear"){
+    }
+    void next(bool Better){
+        Idle = Better ? 0 : Idle+1;
+        if(Reheat > 0 && Idle >= Reheat){
+            Temperature = Start;
+            Idle = 0;
+        }
+        else if(Geometric){
+            Temperature *= Factor;
+        }
+        else{
+            Temperature = std::max(Temperature - Decrement, 0.0);
+        }
+    }
+
+    double Start;
+    double Temperature;
+    double Decrement;
+    double Factor;
+    unsigned Reheat;
+    unsigned Idle;
+    bool Geometric;
+};
+/**
+ * The barrier of the replicas of the tempering engine. The last replica,
+ * that arrives, runs the passed action, while the others wait; afterwards
+ * all replicas continue.
+ */
+struct rasbhari::_exchange_barrier{
+    _exchange_barrier(unsigned Count):Count(Count),Waiting(0),Generation(0){
+    }
+    template<typename Action>
+    void wait(Action A){
+        std::unique_lock<std::mutex> Lock(Mutex);
+        unsigned Arrived = Generation;
+        if(++Waiting == Count){
+            A();
+            Waiting = 0;
+            Generation++;
+            Ready.notify_all();
+        }
+        else{
+            Ready.wait(Lock, [this, Arrived](){
+                return Generation != Arrived;
+            });
+        }
+    }
+
+    std::mutex Mutex;
+    std::condition_variable Ready;
+    unsigned Count;
+    unsigned Waiting;
+    unsigned Generation;
+};
+/**
+ * The memory of the tabu engine. For each position of each pattern the step
+ * is stored, until which it may not be swapped again; the Zobrist hashes of
+ * all scored sets are held in an open addressing table. If half of the
+ * table is used, it is cleared and the scored sets are forgotten. The
+ * buffers are reused by the following runs.
+ */
+struct rasbhari::_tabu_memory{
+    void reset(unsigned Size, unsigned Limit, unsigned Tenure){
+        size_t Capacity = 16;
+        while(Capacity < 2*(size_t)Limit && Capacity < MaxVisited){
+            Capacity *= 2;
+        }
+        Visited.assign(Capacity, 0);
+        Used = 0;
+        Until.assign((size_t)Size*pattern::MaxLength, 0);
+        Step = 0;
+        this->Tenure = Tenure;
+    }
+    bool is_tabu(unsigned Idx, unsigned PosA, unsigned PosB) const{
+        const unsigned long * Pat = &Until[(size_t)Idx*pattern::MaxLength];
+        return Pat[PosA] > Step || Pat[PosB] > Step;
+    }
+    void make_tabu(unsigned Idx, unsigned PosA, unsigned PosB){
+        unsigned long * Pat = &Until[(size_t)Idx*pattern::MaxLength];
+        Pat[PosA] = Step + Tenure;
+        Pat[PosB] = Step + Tenure;
+    }
+    size_t find(uint64_t Hash) const{
+        size_t Mask = Visited.size()-1, Slot = (Hash ^ (Hash >> 32)) & Mask;
+        while(Visited[Slot] != 0 && Visited[Slot] != Hash){
+            Slot = (Slot+1) & Mask;
+        }
+        return Slot;
+    }
+    bool visited(uint64_t Hash) const{
+        Hash |= Hash == 0;
+        return Visited[find(Hash)] == Hash;
+    }
+    void insert(uint64_t Hash){
+        Hash |= Hash == 0;
+        if(2*(Used+1) > Visited.size()){
+            std::fill(Visited.begin(), Visited.end(), 0);
+            Used = 0;
+        }
+        uint64_t & Slot = Visited[find(Hash)];
+        if(Slot == 0){
+            Slot = Hash;
+            Used++;
+        }
+    }
+
+    std::vector<uint64_t> Visited;
+    std::vector<unsigned long> Until;
+    size_t Used;
+    unsigned long Step;
+    unsigned Tenure;
+};
+/**
+ * The elite pool of the memetic restarts; holds the best distinct pattern
+ * sets, the best first. Sets are told apart by the Zobrist hash of their
+ * patterns in a canonical order, such that the same patterns in another
+ * order are the same set. A set is taken, if the pool is not full or if it
+ * is better than the worst set of the pool, which is dropped.
+ * The restart workers share one pool, all access is guarded by its mutex.
+ */
+struct rasbhari::_elite_pool{
+    struct member{
+        patternset Set;
+        uint64_t Hash;
+        double Score;
+        rasbhari_compute::oc_int OcScore;
+    };
+    static uint64_t canonical_hash(const patternset & Set){
+        static thread_local std::vector<pattern> Sorted;
+        static thread_local patternset Canonical;
+        Sorted.clear();
+        for(unsigned i = 0; i < Set.size(); i++){
+            Sorted.push_back(Set[i]);
+        }
+        std::sort(Sorted.begin(), Sorted.end(), [](const pattern & A, const pattern & B){
+            if(A.length() != B.length()){
+                return A.length() < B.length();
+            }
+            uint64_t WordsA[pattern::MaxLength/64], WordsB[pattern::MaxLength/64];
+            A.get_words(WordsA, pattern::MaxLength/64);
+            B.get_words(WordsB, pattern::MaxLength/64);
+            return std::lexicographical_compare(WordsA, WordsA+pattern::MaxLength/64, WordsB, WordsB+pattern::MaxLength/64);
+        });
+        Canonical.clear();
+        for(pattern & Pat : Sorted){
+            Canonical.push_back(Pat);
+        }
+        return Canonical.hash();
+    }
+    _elite_pool(unsigned Capacity): Capacity(Capacity){
+    }
+    bool pick(rng & Rng, patternset & First, patternset & Second){
+        std::lock_guard<std::mutex> Lock(Mutex);
+        if(Capacity < 2 || Members.size() < Capacity){
+            return false;
+        }
+        unsigned A = Rng.below(Members.size()), B = Rng.below(Members.size()-1);
+        B += B >= A;
+        First = Members[A].Set;
+        Second = Members[B].Set;
+        return true;
+    }
+    void offer(const patternset & Set, double Score, rasbhari_compute::oc_int OcScore, bool Exact){
+        if(Capacity == 0){
+            return;
+        }
+        uint64_t Hash = canonical_hash(Set);
+        std::lock_guard<std::mutex> Lock(Mutex);
+        for(const member & Member : Members){
+            if(Member.Hash == Hash){
+                return;
+            }
+        }
+        auto Worse = [Exact, Score, OcScore](const member & Member){
+            return Exact ? Member.OcScore > OcScore : Member.Score > Score;
+        };
+        if(Members.size() >= Capacity){
+            if(!Worse(Members.back())){
+                return;
+            }
+            Members.pop_back();
+        }
+        Members.insert(std::find_if(Members.begin(), Members.end(), Worse), member{Set, Hash, Score, OcScore});
+    }
+
+    std::vector<member> Members;
+    unsigned Capacity;
+    std::mutex Mutex;
+};
+/**
+ * An entry of the objective registry: the name of the objective, as given
+ * by '--objective', its label, if it counts overlaps like the overlap
+ * complexity, such that its default pattern lengths are used, and the
+ * function, that passes its policy to a call.
+ */
+template<typename Call>
+struct rasbhari::_objective{
+    const char * Name;
+    const char * Label;
+    bool Overlap;
+    typename Call::result_type (rasbhari::*Dispatch)(const Call & C);
+};
+/**
+ * The registry of all objectives, that can be optimised; the only place,
+ * where an objective policy is mapped to its name. A new objective needs its
+ * policy in rasbhari_compute, a dispatch function, that builds the policy,
+ * and a row here; '--objective', the label and the default pattern lengths
+ * follow from the row.
+ *
+ * @return              The entries of all objectives, the default first.
+ */
+template<typename Call>
+const std::vector< rasbhari::_objective<Call> > & rasbhari::_objectives(){
+    static const std::vector< _objective<Call> > Objectives = {
+        {"oc", "Overlap complexity", true, &rasbhari::_dispatch_oc<Call>},
+        {"variance", "Variance", false, &rasbhari::_dispatch_variance<Call>},
+        {"woc", "Weighted overlap complexity", true, &rasbhari::_dispatch_woc<Call>}
+    };
+    return Objectives;
+}
+/**
+ * Looks up an objective in the registry.
+ *
+ * @param Name          The name of the objective.
+ *
+ * @return              The entry of the objective, nullptr if unknown.
+ */
+template<typename Call>
+const rasbhari::_objective<Call> * rasbhari::_find_objective(const std::string & Name){
+    for(const _objective<Call> & Objective : _objectives<Call>()){
+        if(Name == Objective.Name){
+            return &Objective;
+        }
+    }
+    return nullptr;
+}
+/**
+ * Chooses the policy of the configured objective from the registry and the
+ * length class of the set and passes the policy to the call. Sets of
+ * patterns with at most 64, 128 or pattern::MaxLength positions use the
+ * fixed-length overlap kernels. An unknown objective is treated as the
+ * default one.
+ *
+ * @param Call          The policy based internal function to be called.
+ *
+ * @return              The result of the call.
+ */
+template<typename Call>
+typename Call::result_type rasbhari::_dispatch(const Call & C){
+    const _objective<Call> * Objective = _find_objective<Call>(_Config.Objective);
+    if(!Objective){
+        Objective = &_objectives<Call>().front();
+    }
+    return (this->*Objective->Dispatch)(C);
+}
+/**
+ * Passes the policy of the overlap complexity to the call. The overlap
+ * complexity of sets, whose sum could exceed oc_int, is computed as weighted
+ * overlap complexity with base 2, i.e. with doubles.
+ *
+ * @param Call          The policy based internal function to be called.
+ *
+ * @return              The result of the call.
+ */
+template<typename Call>
+typename Call::result_type rasbhari::_dispatch_oc(const Call & C){
+    uint64_t Size = _RasbhariPattern.size(), Shifts = Size*(Size+1)/2*(2*_RasbhariPattern.max_length());
+    if(!rasbhari_compute::oc_exact(_RasbhariPattern.max_weight(), Shifts)){
+        return _dispatch_length(C, rasbhari_compute::woc_objective(_oc_table()));
+    }
+    return _dispatch_length(C, rasbhari_compute::oc_objective());
+}
+/**
+ * Passes the policy of the variance to the call.
+ *
+ * @param Call          The policy based internal function to be called.
+ *
+ * @return              The result of the call.
+ */
+template<typename Call>
+typename Call::result_type rasbhari::_dispatch_variance(const Call & C){
+    return _dispatch_length(C, rasbhari_compute::var_objective(_var_table()));
+}
+/**
+ * Passes the policy of the weighted overlap complexity to the call.
+ *
+ * @param Call          The policy based internal function to be called.
+ *
+ * @return              The result of the call.
+ */
+template<typename Call>
+typename Call::result_type rasbhari::_dispatch_woc(const Call & C){
+    return _dispatch_length(C, rasbhari_compute::woc_objective(_woc_table()));
+}
+/**
+ * Passes the objective policy, wrapped into the length class of the set, to
+ * the call.
+ *
+ * @param Call          The policy based internal function to be called.
+ *
+ * @param Obj           The objective policy, OC or variance.
+ *
+ * @return              The result of the call.
+ */
+template<typename Call, typename Objective>
+typename Call::result_type rasbhari::_dispatch_length(const Call & C, const Objective & Obj){
+    unsigned MaxLength = _RasbhariPattern.max_length();
+    if(MaxLength <= 64){
+        return C(*this, rasbhari_compute::fixed_objective<Objective,1>(Obj));
+    }
+    if(MaxLength <= 128){
+        return C(*this, rasbhari_compute::fixed_objective<Objective,2>(Obj));
+    }
+    return C(*this, rasbhari_compute::fixed_objective<Objective,4>(Obj));
+}
+/**
+ * The patterns keep their position in the set, which is also their index in
+ * the coefficient matrix. The optimising steps visit the patterns by their
+ * contribution, this order is held by an index list.
+ */
+void rasbhari::_make_order(){
+    _Order.resize(_RasbhariPattern.size());
+    for(unsigned i = 0; i < _RasbhariPattern.size(); i++){
+        _RasbhariPattern.set_idx(i, i);
+        _Order[i] = i;
+    }
+}
+/**
+ * Returns a copy of the pattern set in the order of the contributions.
+ *
+ * @return              The ordered pattern set.
+ */
+patternset rasbhari::_ordered_set() const{
+    patternset Ordered;
+    for(unsigned Idx : _Order){
+        Ordered.push_back(_RasbhariPattern[Idx]);
+    }
+    return Ordered;
+}
+/**
+ * Sorts the order list by the contribution of the patterns, lowest first,
+ * and stores the contributions as pattern scores. After a single accepted
+ * step the previous order is nearly sorted, then it is repaired by an
+ * insertion sort in almost linear time.
+ *
+ * @param Full          True, if the order has to be sorted from scratch.
+ */
+template<typename Value>
+void rasbhari::_sort_order(bool Full){
+    const coefmatrix<Value> & CoefMat = _coef_mat<Value>();
+    if(Full){
+        std::sort(_Order.begin(), _Order.end(), [&CoefMat](unsigned A, unsigned B){
+            return CoefMat.row_sum(A) < CoefMat.row_sum(B);
+        });
+    }
+    else{
+        for(unsigned i = 1; i < _Order.size(); i++){
+            unsigned Idx = _Order[i], j = i;
+            Value Contribution = CoefMat.row_sum(Idx);
+            for(; j > 0 && Contribution < CoefMat.row_sum(_Order[j-1]); j--){
+                _Order[j] = _Order[j-1];
+            }
+            _Order[j] = Idx;
+        }
+    }
+    for(unsigned i = 0; i < _RasbhariPattern.size(); i++){
+        _RasbhariPattern.set_score(i, (double)CoefMat.row_sum(i));
+    }
+}
+/**
+ * For the entire set, the total coef_matrix is set up and pattern contribution
+ * were calculated. This part is only the initial step. Changes on patterns
+ * are only for single patterns, thus only one column and row changes!
+ */
+void rasbhari::calculate(){
+    _dispatch(_calculate_call());
+}
+/**
+ * Sets up the total coef_matrix for a fixed objective policy. As the matrix
+ * is symmetric, only the upper triangle is computed; it is split into tiles
+ * of TileSize x TileSize pattern pairs, which are processed in parallel, if
+ * the set has at least ParallelSize patterns. At most _Threads threads are
+ * used; a single one, if no number of threads is set.
+ *
+ * @param Obj           The objective policy, OC or variance.
+ */
+template<typename Objective>
+void rasbhari::_calculate(const Objective & Obj){
+    typedef typename Objective::value_type value_type;
+    coefmatrix<value_type> & CoefMat = _coef_mat<value_type>();
+    value_type & Score = _score<value_type>();
+    unsigned Size = _RasbhariPattern.size();
+    bool UseProfiles = _make_profiles();
+    if(CoefMat.size() != Size){
+        CoefMat = coefmatrix<value_type>(Size);
+    }
+    std::vector< std::pair<unsigned,unsigned> > Tiles;
+    for(unsigned i = 0; i < Size; i += TileSize){
+        for(unsigned j = i; j < Size; j += TileSize){
+            Tiles.push_back(std::make_pair(i,j));
+        }
+    }
+    std::atomic<unsigned> NextTile(0);
+    auto Worker = [&](){
+        for(unsigned t = NextTile++; t < Tiles.size(); t = NextTile++){
+            _calculate_tile(Tiles[t].first, Tiles[t].second, UseProfiles, Obj);
+        }
+    };
+    unsigned Threads = 1;
+    if(Size >= ParallelSize){
+        Threads = std::max(1u, std::min<unsigned>(_Threads, Tiles.size()));
+    }
+    std::vector<std::thread> Pool;
+    for(unsigned t = 1; t < Threads; t++){
+        Pool.push_back(std::thread(Worker));
+    }
+    Worker();
+    for(auto & Thread : Pool){
+        Thread.join();
+    }
+
+    for(unsigned i = 0; i < Size; i++){
+        CoefMat.assign(i, i, Obj.self(_RasbhariPattern[i]));
+    }
+    CoefMat.sum_rows();
+    Score = CoefMat.sum();
+    _RasbhariScore = Score;
+    _sort_order<value_type>(true);
+}
+/**
+ * Computes the pair coefficients i < j of a single tile of the coef_matrix
+ * and, if used, their overlap profiles. In bit mode a row pattern is
+ * compared with all column patterns of the tile at once: for each shift the
+ * AND and popcount runs over the contiguous bit patterns of the tile, such
+ * that the inner loop can be vectorised. Longer patterns are computed pair
+ * by pair.
+ *
+ * @param RowBegin      The first row of the tile.
+ *
+ * @param ColBegin      The first column of the tile.
+ *
+ * @param UseProfiles   True, if the overlap profiles have to be written.
+ *
+ * @param Obj           The objective policy, OC or variance.
+ */
+template<typename Objective>
+void rasbhari::_calculate_tile(unsigned RowBegin, unsigned ColBegin, bool UseProfiles, const Objective & Obj){
+    typedef typename Objective::value_type value_type;
+    static thread_local std::vector<unsigned> Overlaps;
+    coefmatrix<value_type> & CoefMat = _coef_mat<value_type>();
+    unsigned Size = _RasbhariPattern.size();
+    unsigned RowEnd = std::min(Size, RowBegin+TileSize), ColEnd = std::min(Size, ColBegin+TileSize);
+    uint64_t Bits[TileSize];
+    unsigned Lengths[TileSize], Counts[TileSize];
+    uint16_t * Profiles[TileSize];
+    value_type Coefs[TileSize];
+    typename Objective::pair_term Terms[TileSize];
+
+    for(unsigned i = RowBegin; i < RowEnd; i++){
+        const pattern & Pat = _RasbhariPattern[i];
+        unsigned First = std::max(ColBegin, i+1), Cols = 0, MaxLength = 0;
+        bool IsBit = Pat.length() < 64;
+        for(unsigned j = First; j < ColEnd; j++){
+            IsBit = IsBit && _RasbhariPattern[j].length() < 64;
+        }
+        for(unsigned j = First; j < ColEnd && IsBit; j++, Cols++){
+            Bits[Cols] = _RasbhariPattern[j].bits();
+            Lengths[Cols] = _RasbhariPattern[j].length();
+            Profiles[Cols] = UseProfiles ? &_Profiles[_ProfileOffset[i*Size+j]] : nullptr;
+            Terms[Cols] = Obj.term(Pat, _RasbhariPattern[j]);
+            Coefs[Cols] = 0;
+            MaxLength = std::max(MaxLength, Lengths[Cols]);
+        }
+        for(unsigned j = First; j < ColEnd && !IsBit; j++){
+            Obj.overlaps(Pat, _RasbhariPattern[j], Overlaps);
+            auto T = Obj.term(Pat, _RasbhariPattern[j]);
+            value_type Coef = 0;
+            for(unsigned Overlap : Overlaps){
+                Coef += T(Overlap);
+            }
+            if(UseProfiles){
+                std::copy(Overlaps.begin(), Overlaps.end(), _Profiles.begin() + _ProfileOffset[i*Size+j]);
+            }
+            CoefMat.assign(i, j, Coef);
+        }
+        if(Cols == 0){
+            continue;
+        }
+
+        uint64_t BitPat = Pat.bits();
+        unsigned Length = Pat.length();
+        for(unsigned Shift = Length; Shift-- > 0;){
+            uint64_t ShiftPattern = BitPat >> Shift;
+            for(unsigned c = 0; c < Cols; c++){
+                Counts[c] = popcount(ShiftPattern & Bits[c]);
+            }
+            for(unsigned c = 0; c < Cols; c++){
+                Coefs[c] += Terms[c](Counts[c]);
+                if(UseProfiles){
+                    Profiles[c][Length-1-Shift] = Counts[c];
+                }
+            }
+        }
+        for(unsigned Shift = 1; Shift < MaxLength; Shift++){
+            for(unsigned c = 0; c < Cols; c++){
+                Counts[c] = popcount((Bits[c] >> Shift) & BitPat);
+            }
+            for(unsigned c = 0; c < Cols; c++){
+                if(Shift < Lengths[c]){
+                    Coefs[c] += Terms[c](Counts[c]);
+                    if(UseProfiles){
+                        Profiles[c][Length-1+Shift] = Counts[c];
+                    }
+                }
+            }
+        }
+        for(unsigned c = 0; c < Cols; c++){
+            CoefMat.assign(i, First+c, Coefs[c]);
+        }
+    }
+}
+
+/**
+ * Calculates for a specific pair either the overlap complexity or the variance.
+ * 
+ * @param Idx1          The index of the first pattern of a pattern pair.
+ *
+ * @param Idx2          The index of the second pattern of a pattern pair.
+ *
+ * @return              The OC/variance of the pattern pair.
+ */
+double rasbhari::calculate_pair(size_t Idx1, size_t Idx2){
+    _pair_call Call;
+    Call.Idx1 = Idx1;
+    Call.Idx2 = Idx2;
+    return _dispatch(Call);
+}
+/**
+ * Returns the variance table for the current options; the table is only
+ * rebuilt, if one of the parameters P, Q, S or W has changed.
+ *
+ * @return              The variance table.
+ */
+const rasbhari_compute::var_table & rasbhari::_var_table(){
+    if(!_VarTable.matches(_Config.P, _Config.Q, _Config.SeqLength, _Config.Weight)){
+        _VarTable = rasbhari_compute::var_table(_Config.P, _Config.Q, _Config.SeqLength, _Config.Weight);
+    }
+    return _VarTable;
+}
+/**
+ * Returns the power table of the weighted overlap complexity for the current
+ * options; the table is only rebuilt, if P or W has changed.
+ *
+ * @return              The weighted OC table.
+ */
+const rasbhari_compute::woc_table & rasbhari::_woc_table(){
+    if(!_WocTable.matches(1/_Config.P, _Config.Weight)){
+        _WocTable = rasbhari_compute::woc_table(1/_Config.P, _Config.Weight);
+    }
+    return _WocTable;
+}
+/**
+ * Returns the power table of the overlap complexity, used for sets, whose
+ * overlap complexity is not held by oc_int; the base is 2.
+ *
+ * @return              The OC table.
+ */
+const rasbhari_compute::woc_table & rasbhari::_oc_table(){
+    if(!_OcTable.matches(2, _Config.Weight)){
+        _OcTable = rasbhari_compute::woc_table(2, _Config.Weight);
+    }
+    return _OcTable;
+}
+/**
+ * Checks, if the current objective has exact integer coefficients; then the
+ * exact matrix and score are used.
+ *
+ * @return              True, if the objective is exact.
+ */
+bool rasbhari::_exact(){
+    return _dispatch(_exact_call());
+}
+/**
+ * If whished, calculates for the entire patternset the sensitivity.
+ */
+void rasbhari::calculate_sensitivity(){
+    if(_State.Sens){
+        _RasbhariSensitivity = rasbhari_compute::sensitivity(_RasbhariPattern, _Config, _State);
+    }
+}
+
+/**
+ * Changes on one pattern will change the coef_matrix in only one row and one
+ * column, therefore the OC/variance coefficient only needs to be updated!
+ *
+ * @param Idx           The index of the pattern that was permutated randomly.
+ */
+void rasbhari::update(unsigned Idx){
+    _update_call Call;
+    Call.Idx = Idx;
+    _dispatch(Call);
+}
+/**
+ * Updates the row and column of a changed pattern for a fixed objective
+ * policy.
+ *
+ * @param Idx           The index of the pattern that was permutated randomly.
+ *
+ * @param Obj           The objective policy, OC or variance.
+ */
+template<typename Objective>
+void rasbhari::_update(unsigned Idx, const Objective & Obj){
+    typedef typename Objective::value_type value_type;
+    coefmatrix<value_type> & CoefMat = _coef_mat<value_type>();
+    value_type & Score = _score<value_type>();
+    for(unsigned i = 0; i < _RasbhariPattern.size(); i++){
+        value_type Coef;
+        if(i == Idx){
+            Coef = Obj.self(_RasbhariPattern[i]);
+        }
+        else{
+            Coef = Obj.pair(_RasbhariPattern[i],_RasbhariPattern[Idx]);
+            if(!_Profiles.empty()){
+                _make_profile(std::min(i,Idx), std::max(i,Idx));
+            }
+        }
+        Score -= CoefMat.get(i, Idx);
+        CoefMat.set(i, Idx, Coef);
+        Score += Coef;
+    }
+    _RasbhariScore = Score;
+}
+/**
+ * Updates the row and column of a pattern after a single swap of a match
+ * and a don't care position. Only the overlaps of the shifts, that align
+ * one of the swapped positions with a match position of the other pattern,
+ * change by one; thus the stored overlap profiles and the pair coefficients
+ * are updated with O(weight) operations per pattern pair.
+ *
+ * @param Idx           The index of the swapped pattern.
+ *
+ * @param OffPos        The former match position, now a don't care.
+ *
+ * @param OnPos         The former don't care position, now a match.
+ *
+ * @param Obj           The objective policy, OC or variance.
+ */
+template<typename Objective>
+void rasbhari::_update_swap(unsigned Idx, unsigned OffPos, unsigned OnPos, const Objective & Obj){
+    typedef typename Objective::value_type value_type;
+    coefmatrix<value_type> & CoefMat = _coef_mat<value_type>();
+    value_type & Score = _score<value_type>();
+    for(unsigned i = 0; i < _RasbhariPattern.size(); i++){
+        value_type OldCoef = CoefMat.get(i, Idx), Coef;
+        if(i == Idx){
+            Coef = Obj.self(_RasbhariPattern[i]);
+        }
+        else{
+            unsigned First = std::min(i,Idx), Second = std::max(i,Idx);
+            Coef = OldCoef + _swap_profile<value_type>(Idx, i, OffPos, OnPos, Obj.term(_RasbhariPattern[First],_RasbhariPattern[Second]));
+        }
+        Score -= OldCoef;
+        CoefMat.set(i, Idx, Coef);
+        Score += Coef;
+    }
+    _RasbhariScore = Score;
+}
+/**
+ * Changes the overlap profile of a pattern pair after a swap in one of the
+ * patterns and returns the change of the pair coefficient.
+ * The profile of the pair (First,Second), First < Second, holds at position
+ * k the overlap for the shift s = k-Second.length()+1.
+ *
+ * @param Idx           The index of the swapped pattern.
+ *
+ * @param Partner       The index of the other pattern of the pair.
+ *
+ * @param OffPos        The former match position, now a don't care.
+ *
+ * @param OnPos         The former don't care position, now a match.
+ *
+ * @param T             The shift contribution of the pattern pair.
+ *
+ * @return              The change of the pair coefficient.
+ */
+template<typename Value, typename Term>
+Value rasbhari::_swap_profile(unsigned Idx, unsigned Partner, unsigned OffPos, unsigned OnPos, const Term & T){
+    bool IsFirst = Idx < Partner;
+    unsigned First = IsFirst ? Idx : Partner, Second = IsFirst ? Partner : Idx;
+    uint16_t * Profile = &_Profiles[_ProfileOffset[First*_RasbhariPattern.size()+Second]];
+    int Base = (int)_RasbhariPattern[Second].length() - 1;
+    Value Delta = 0;
+    for(unsigned Pos : _RasbhariPattern[Partner].match_pos()){
+        int k = IsFirst ? (int)OffPos - (int)Pos + Base : (int)Pos - (int)OffPos + Base;
+        Delta += T(Profile[k]-1) - T(Profile[k]);
+        Profile[k]--;
+    }
+    for(unsigned Pos : _RasbhariPattern[Partner].match_pos()){
+        int k = IsFirst ? (int)OnPos - (int)Pos + Base : (int)Pos - (int)OnPos + Base;
+        Delta += T(Profile[k]+1) - T(Profile[k]);
+        Profile[k]++;
+    }
+    return Delta;
+}
+/**
+ * Undoes the changes of a swap on all overlap profiles of a pattern.
+ *
+ * @param Idx           The index of the swapped pattern.
+ *
+ * @param OffPos        The former match position of the swap.
+ *
+ * @param OnPos         The former don't care position of the swap.
+ */
+void rasbhari::_revert_profiles(unsigned Idx, unsigned OffPos, unsigned OnPos){
+    for(unsigned i = 0; i < _RasbhariPattern.size(); i++){
+        if(i != Idx){
+            _swap_profile<double>(Idx, i, OnPos, OffPos, null_term());
+        }
+    }
+}
+/**
+ * Sets up the layout of the overlap profiles of all pattern pairs, i.e. the
+ * offset of each pair; the profiles are filled by _calculate(). If the
+ * profiles would exceed their share of MaxProfileSize entries, they are not
+ * used; the share is divided by the number of threads, as each restart
+ * worker or replica holds its own profiles.
+ *
+ * @return              True, if the overlap profiles are used.
+ */
+bool rasbhari::_make_profiles(){
+    unsigned Size = _RasbhariPattern.size();
+    size_t Total = 0;
+    _ProfileOffset.assign((size_t)Size*Size, 0);
+    for(unsigned i = 0; i < Size; i++){
+        for(unsigned j = i+1; j < Size; j++){
+            _ProfileOffset[i*Size+j] = Total;
+            Total += _RasbhariPattern[i].length() + _RasbhariPattern[j].length() - 1;
+        }
+    }
+    unsigned Instances = std::max(_Config.Engine == "temper" ? 2u : 1u, _Config.Threads);
+    _Profiles.clear();
+    if(Total > MaxProfileSize/Instances){
+        return false;
+    }
+    _Profiles.resize(Total);
+    return true;
+}
+/**
+ * Rebuilds the overlap profiles of the current set, e.g. for the best set of
+ * the restarts, whose profiles are not kept.
+ */
+void rasbhari::_fill_profiles(){
+    if(!_make_profiles()){
+        return;
+    }
+    for(unsigned i = 0; i < _RasbhariPattern.size(); i++){
+        for(unsigned j = i+1; j < _RasbhariPattern.size(); j++){
+            _make_profile(i, j);
+        }
+    }
+}
+/**
+ * Computes the overlap profile of a single pattern pair.
+ *
+ * @param Idx1          The smaller index of the pattern pair.
+ *
+ * @param Idx2          The larger index of the pattern pair.
+ */
+void rasbhari::_make_profile(unsigned Idx1, unsigned Idx2){
+    static thread_local std::vector<unsigned> Overlaps;
+    _RasbhariPattern[Idx1].get_overlaps(_RasbhariPattern[Idx2], Overlaps);
+    std::copy(Overlaps.begin(), Overlaps.end(), _Profiles.begin() + _ProfileOffset[Idx1*_RasbhariPattern.size()+Idx2]);
+}
+/**
+ * The actual optimising step. The pattern with highest contribute is 
+ * investigated, a random permutation is performed and afterwards it is checked,
+ * if the OC/variance is optimised. If not, the change is undone, otherwise
+ * it is accepted.
+ *
+ * @return              Returns if the permutation was succesfull or not.
+ */
+bool rasbhari::climb_hill(){
+    return _dispatch(_climb_hill_call());
+}
+/**
+ * The optimising step for a fixed objective policy. A rejected step is undone
+ * by the undo log of the changed pattern, not by copies of the whole set.
+ *
+ * @param Obj           The objective policy, OC or variance.
+ *
+ * @return              Returns if the permutation was succesfull or not.
+ */
+template<typename Objective>
+bool rasbhari::_climb_hill(const Objective & Obj){
+    typedef typename Objective::value_type value_type;
+    value_type & Score = _score<value_type>();
+    static thread_local _undo_log<value_type> Log;
+    unsigned Idx = _Order[_PatNo%_Order.size()];
+    Log.record(*this, Idx);
+
+    unsigned OffPos, OnPos;
+    bool Swapped = _RasbhariPattern.random_swap_uniq(Idx, OffPos, OnPos, _Rng);
+    if(_Profiles.empty()){
+        _update(Idx, Obj);
+    }
+    else if(Swapped){
+        _update_swap(Idx, OffPos, OnPos, Obj);
+    }
+    
+    if(Score < Log.Score){
+        _PatNo = 0;
+        _sort_order<value_type>(false);
+        return true;
+    }
+
+    if(Swapped && !_Profiles.empty()){
+        _revert_profiles(Idx, OffPos, OnPos);
+    }
+    Log.restore(*this);
+    _PatNo++;
+    return false;
+}
+/**
+ * The steepest descent step. For the next pattern all swaps of an inner
+ * match position with a don't care position are scored at once and the best
+ * swap is accepted, if it improves the OC/variance.
+ *
+ * @return              Returns if the best swap was an improvement or not.
+ */
+bool rasbhari::climb_hill_steepest(){
+    return _dispatch(_climb_hill_steepest_call());
+}
+/**
+ * The steepest descent step for a fixed objective policy.
+ * For every partner pattern the change of its overlap profile is split into
+ * the part of the former match position (one term per match of the partner)
+ * and the part of the former don't care position; both are computed once
+ * for all candidates. Only shifts, that are hit by both positions, are
+ * corrected per candidate. Without overlap profiles a random step is done.
+ * The candidate buffers are kept by the thread for the following steps.
+ *
+ * @param Obj           The objective policy, OC or variance.
+ *
+ * @return              Returns if the best swap was an improvement or not.
+ */
+template<typename Objective>
+bool rasbhari::_climb_hill_steepest(const Objective & Obj){
+    typedef typename Objective::value_type value_type;
+    if(_Profiles.empty()){
+        return _climb_hill(Obj);
+    }
+    value_type & Score = _score<value_type>();
+    static thread_local _undo_log<value_type> Log;
+    unsigned OrigIdx = _Order[_PatNo%_Order.size()];
+    pattern Pat = _RasbhariPattern[OrigIdx];
+    if(Pat.weight() <= 2 || Pat.dontcare() == 0){
+        _PatNo++;
+        return false;
+    }
+    static thread_local std::vector<unsigned> OffPos, OnPos, Order;
+    static thread_local std::vector<value_type> OffDelta, OnDelta, Delta;
+    pattern::positions Matches = Pat.match_pos(), DontCares = Pat.dc_pos();
+    OffPos.assign(std::next(Matches.begin()), Matches.end());
+    OffPos.pop_back();
+    OnPos.assign(DontCares.begin(), DontCares.end());
+    OffDelta.resize(OffPos.size());
+    OnDelta.resize(OnPos.size());
+    Delta.assign(OffPos.size()*OnPos.size(), -Obj.self(Pat));
+
+    for(unsigned a = 0; a < OffPos.size(); a++){
+        for(unsigned b = 0; b < OnPos.size(); b++){
+            pattern Cand = Pat;
+            Cand.bit_swap(OffPos[a], OnPos[b]);
+            Delta[a*OnPos.size()+b] += Obj.self(Cand);
+        }
+    }
+    for(unsigned i = 0; i < _RasbhariPattern.size(); i++){
+        if(i == OrigIdx){
+            continue;
+        }
+        const pattern & Partner = _RasbhariPattern[i];
+        bool IsFirst = OrigIdx < i;
+        unsigned First = IsFirst ? OrigIdx : i, Second = IsFirst ? i : OrigIdx;
+        const uint16_t * Profile = &_Profiles[_ProfileOffset[First*_RasbhariPattern.size()+Second]];
+        int Base = (int)_RasbhariPattern[Second].length() - 1;
+        auto T = Obj.term(_RasbhariPattern[First], _RasbhariPattern[Second]);
+        for(unsigned a = 0; a < OffPos.size(); a++){
+            OffDelta[a] = 0;
+            for(unsigned Pos : Partner.match_pos()){
+                int k = IsFirst ? (int)OffPos[a] - (int)Pos + Base : (int)Pos - (int)OffPos[a] + Base;
+                OffDelta[a] += T(Profile[k]-1) - T(Profile[k]);
+            }
+        }
+        for(unsigned b = 0; b < OnPos.size(); b++){
+            OnDelta[b] = 0;
+            for(unsigned Pos : Partner.match_pos()){
+                int k = IsFirst ? (int)OnPos[b] - (int)Pos + Base : (int)Pos - (int)OnPos[b] + Base;
+                OnDelta[b] += T(Profile[k]+1) - T(Profile[k]);
+            }
+        }
+        for(unsigned a = 0; a < OffPos.size(); a++){
+            value_type * Row = &Delta[a*OnPos.size()];
+            for(unsigned b = 0; b < OnPos.size(); b++){
+                Row[b] += OffDelta[a] + OnDelta[b];
+            }
+            for(unsigned b = 0; b < OnPos.size(); b++){
+                int Lag = (int)OnPos[b] - (int)OffPos[a];
+                for(unsigned Pos : Partner.match_pos()){
+                    int Other = (int)Pos + Lag;
+                    if(Other >= 0 && Other < (int)Partner.length() && Partner.is_match(Other)){
+                        int k = IsFirst ? (int)OffPos[a] - (int)Pos + Base : (int)Pos - (int)OffPos[a] + Base;
+                        unsigned Overlap = Profile[k];
+                        Row[b] -= T(Overlap-1) + T(Overlap+1) - 2*T(Overlap);
+                    }
+                }
+            }
+        }
+    }
+
+    Order.resize(Delta.size());
+    for(unsigned i = 0; i < Order.size(); i++){
+        Order[i] = i;
+    }
+    std::sort(Order.begin(), Order.end(), [](unsigned A, unsigned B){
+        return Delta[A] < Delta[B];
+    });
+    for(unsigned Cand : Order){
+        if(Delta[Cand] >= 0){
+            break;
+        }
+        unsigned Off = OffPos[Cand/OnPos.size()], On = OnPos[Cand%OnPos.size()];
+        if(!_RasbhariPattern.is_uniq_swap(OrigIdx, Off, On)){
+            continue;
+        }
+        Log.record(*this, OrigIdx);
+        _RasbhariPattern.bit_swap(OrigIdx, Off, On);
+        _update_swap(OrigIdx, Off, On, Obj);
+        if(Score < Log.Score){
+            _PatNo = 0;
+            _sort_order<value_type>(false);
+            return true;
+        }
+        _revert_profiles(OrigIdx, Off, On);
+        Log.restore(*this);
+        break;
+    }
+    _PatNo++;
+    return false;
 }
-
 /**
- * Since often needed a function that resets the coefficient matrix for oc/var.
+ * The annealing step. A random pattern is modified by a random permutation;
+ * an improvement or an equal score is always accepted, a worse score by the
+ * Metropolis rule with the passed temperature. A rejected step is undone.
+ *
+ * @param Temperature   The temperature, in units of the OC/variance.
+ *
+ * @return              Returns if the permutation was accepted or not.
  */
-void rasbhari::_adjust_coef_mat(){
-    _CoefMat = std::vector< std::vector<double> >(_RasbhariPattern.size(),std::vector<double>(_RasbhariPattern.size(),0));
+bool rasbhari::climb_hill_anneal(double Temperature){
+    _climb_hill_anneal_call Call;
+    Call.Temperature = Temperature;
+    return _dispatch(Call);
 }
 /**
- * Since the order of the the rasbhari pattern changes due to the changing
- * contribution by random permutations, another list is needed, holding
- * the correct order for the coefficient matrix.
+ * The annealing step for a fixed objective policy; it is scored by the same
+ * incremental update as the optimising step. The pattern is drawn at random,
+ * as after accepted worse steps the order of the contributions does not
+ * point to the pattern to improve.
+ *
+ * @param Obj           The objective policy, OC or variance.
+ *
+ * @param Temperature   The temperature, in units of the OC/variance; 0
+ *                          accepts no worse step.
+ *
+ * @return              Returns if the permutation was accepted or not.
  */
-void rasbhari::_make_pattern_list(){
-    _PatternList = std::vector<pattern>(_RasbhariPattern.size());
-    for(unsigned i = 0; i < _RasbhariPattern.size(); i++){
-        _RasbhariPattern[i].set_idx(i);
-        _PatternList[i] = _RasbhariPattern[i];
+template<typename Objective>
+bool rasbhari::_climb_hill_anneal(const Objective & Obj, double Temperature){
+    typedef typename Objective::value_type value_type;
+    value_type & Score = _score<value_type>();
+    static thread_local _undo_log<value_type> Log;
+    unsigned Idx = _Rng.below(_RasbhariPattern.size());
+    Log.record(*this, Idx);
+
+    unsigned OffPos, OnPos;
+    bool Swapped = _RasbhariPattern.random_swap_uniq(Idx, OffPos, OnPos, _Rng);
+    if(_Profiles.empty()){
+        _update(Idx, Obj);
     }
-}
-/**
- * For the entire set, the total coef_matrix is set up and pattern contribution
- * were calculated. This part is only the initial step. Changes on patterns
- * are only for single patterns, thus only one column and row changes!
- */
-void rasbhari::calculate(){
-    for(unsigned i = 0; i < _PatternList.size(); i++){
-        double CoefPat = 0;
-        for(unsigned j = 0; j < _PatternList.size(); j++){
-            _CoefMat[i][j] = calculate_pair(i,j);
-            CoefPat += _CoefMat[i][j];
-        }
-        _PatternList[i].set_score(CoefPat);
+    else if(Swapped){
+        _update_swap(Idx, OffPos, OnPos, Obj);
     }
-    _RasbhariScore = 0;
-    for(unsigned i = 0; i < _PatternList.size(); i++){
-        for(unsigned j = i; j < _PatternList.size(); j++){
-            _RasbhariScore += _CoefMat[i][j];
+
+    if(!(Log.Score < Score)){
+        _sort_order<value_type>(false);
+        return true;
+    }
+    if(Temperature > 0){
+        double Delta = (double)Score - (double)Log.Score;
+        double Uniform = (_Rng() >> 11)/9007199254740992.0;
+        if(Uniform < std::exp(-Delta/Temperature)){
+            _sort_order<value_type>(false);
+            return true;
         }
     }
-    for(auto & Pat : _RasbhariPattern){
-        Pat.set_score(_PatternList[Pat.idx()].score());
+
+    if(Swapped && !_Profiles.empty()){
+        _revert_profiles(Idx, OffPos, OnPos);
     }
+    Log.restore(*this);
+    return false;
 }
-
 /**
- * Calculates for a specific pair either the overlap complexity or the variance.
- * 
- * @param Idx1          The index of the first pattern of a pattern pair.
+ * Calibrates the start temperature of the annealing engine. AnnealSample
+ * random permutations are scored and undone; the temperature is chosen such
+ * that the mean worsening of the sample is accepted with the probability
+ * of the '--temp' option.
  *
- * @param Idx2          The index of the second pattern of a pattern pair.
+ * @param Obj           The objective policy, OC or variance.
  *
- * @return              The OC/variance of the pattern pair.
+ * @return              The start temperature; 0, if no permutation was worse.
  */
-double rasbhari::calculate_pair(size_t Idx1, size_t Idx2){
-    if(rasb_opt::Oc){
-        return rasbhari_compute::pair_coef_oc(_PatternList[Idx1],_PatternList[Idx2]);
+template<typename Objective>
+double rasbhari::_anneal_start(const Objective & Obj){
+    typedef typename Objective::value_type value_type;
+    const value_type & Score = _score<value_type>();
+    static thread_local _undo_log<value_type> Log;
+    double Worse = 0;
+    unsigned Ctr = 0;
+    for(unsigned i = 0; i < AnnealSample; i++){
+        unsigned Idx = _Rng.below(_RasbhariPattern.size());
+        Log.record(*this, Idx);
+        unsigned OffPos, OnPos;
+        if(!_RasbhariPattern.random_swap_uniq(Idx, OffPos, OnPos, _Rng)){
+            continue;
+        }
+        if(_Profiles.empty()){
+            _update(Idx, Obj);
+        }
+        else{
+            _update_swap(Idx, OffPos, OnPos, Obj);
+            _revert_profiles(Idx, OffPos, OnPos);
+        }
+        if(Log.Score < Score){
+            Worse += (double)Score - (double)Log.Score;
+            Ctr++;
+        }
+        Log.restore(*this);
     }
-    if(Idx1 == Idx2){
-        return rasbhari_compute::pair_coef_var_sym(_PatternList[Idx1],_PatternList[Idx2]);
+    if(Ctr == 0){
+        return 0;
     }
-    return rasbhari_compute::pair_coef_var(_PatternList[Idx1],_PatternList[Idx2]);    
+    return -(Worse/Ctr)/std::log(_Config.Temp);
 }
 /**
- * If whished, calculates for the entire patternset the sensitivity.
+ * The tabu step for a fixed objective policy. As in the optimising step the
+ * pattern with the highest contribution is investigated; a random swap is
+ * skipped without scoring, if it changes a position, that was swapped
+ * within the tenure, or if it leads to a set, that was scored before. A
+ * swap, that does not worsen the OC/variance, is accepted and its positions
+ * become tabu, such that equal sets can be walked without going back.
+ *
+ * @param Obj           The objective policy, OC or variance.
+ *
+ * @param Memory        The tabu memory of the run.
+ *
+ * @return              Returns if the permutation was an improvement or not.
  */
-void rasbhari::calculate_sensitivity(){
-    if(rasb_opt::Sens){
-        _RasbhariSensitivity = rasbhari_compute::sensitivity(_RasbhariPattern);
+template<typename Objective>
+bool rasbhari::_climb_hill_tabu(const Objective & Obj, _tabu_memory & Memory){
+    typedef typename Objective::value_type value_type;
+    value_type & Score = _score<value_type>();
+    static thread_local _undo_log<value_type> Log;
+    unsigned Idx = _Order[_PatNo%_Order.size()];
+    unsigned OffPos, OnPos;
+    Memory.Step++;
+    if(!_RasbhariPattern[Idx].random_positions(_Rng, OffPos, OnPos) || Memory.is_tabu(Idx, OffPos, OnPos)
+        || !_RasbhariPattern.is_uniq_swap(Idx, OffPos, OnPos)){
+        _PatNo++;
+        return false;
     }
-}
+    uint64_t Hash = _RasbhariPattern.swap_hash(Idx, OffPos, OnPos);
+    if(Memory.visited(Hash)){
+        _PatNo++;
+        return false;
+    }
+    Memory.insert(Hash);
 
-/**
- * Changes on one pattern will change the coef_matrix in only one row and one
- * column, therefore the OC/variance coefficient only needs to be updated!
- *
- * @param Idx           The index of the pattern that was permutated randomly.
- */
-void rasbhari::update(unsigned Idx){
-    double CoefPat = 0;
-    for(unsigned i = 0; i < _PatternList.size(); i++){
-        _RasbhariScore -= _CoefMat[i][Idx];
-        double PatternScore = _PatternList[i].score() - _CoefMat[i][Idx];
-        _CoefMat[i][Idx] = calculate_pair(i,Idx);
-        _CoefMat[Idx][i] = _CoefMat[i][Idx];
-        CoefPat += _CoefMat[i][Idx];
-        _PatternList[i].set_score(PatternScore+_CoefMat[i][Idx]);
-        _RasbhariScore += _CoefMat[i][Idx];
+    Log.record(*this, Idx);
+    _RasbhariPattern.bit_swap(Idx, OffPos, OnPos);
+    if(_Profiles.empty()){
+        _update(Idx, Obj);
     }
-    _PatternList[Idx].set_score(CoefPat);
-    for(auto & Pat : _RasbhariPattern){
-        Pat.set_score(_PatternList[Pat.idx()].score());
+    else{
+        _update_swap(Idx, OffPos, OnPos, Obj);
     }
+
+    if(!(Log.Score < Score)){
+        bool Better = Score < Log.Score;
+        Memory.make_tabu(Idx, OffPos, OnPos);
+        _PatNo = Better ? 0 : _PatNo+1;
+        _sort_order<value_type>(false);
+        return Better;
+    }
+
+    if(!_Profiles.empty()){
+        _revert_profiles(Idx, OffPos, OnPos);
+    }
+    Log.restore(*this);
+    _PatNo++;
+    return false;
 }
 /**
- * The actual optimising step. The pattern with highest contribute is 
- * investigated, a random permutation is performed and afterwards it is checked,
- * if the OC/variance is optimised. If not, the change is undone, otherwise
- * it is accepted.
+ * The tempering engine. One replica of the set per thread, at least two,
+ * anneals at a fixed temperature of a ladder; the ladder starts at 0 and
+ * rises geometrically to the calibrated start temperature of the annealing
+ * engine. Every ExchangeInterval steps the replicas meet at a barrier and
+ * neighbouring replicas swap their temperatures by the Metropolis rule of
+ * their scores, alternating between the even and the odd pairs. The replica
+ * at temperature 0 never gets worse, its set is taken at the end.
+ * Each replica has its own random stream, split off the stream of this
+ * instance by jumps, such that a seeded run can be repeated.
  *
- * @return              Returns if the permutation was succesfull or not.
+ * @param Limit         The number of annealing steps of each replica.
+ *
+ * @param Report        True, if the progress is printed.
+ *
+ * @param Obj           The objective policy, OC or variance.
+ *
+ * @return              The number of exchanges, that improved the set at
+ *                          temperature 0.
  */
-bool rasbhari::climb_hill(){
-    unsigned PatIdx = _PatNo%_RasbhariPattern.size();
-    unsigned OrigIdx = _RasbhariPattern[PatIdx].idx();
-
-    double LastCoef = _RasbhariScore;
-    pattern LastPattern = _RasbhariPattern[PatIdx];
-    std::vector< std::vector<double> > LastCMat = _CoefMat;
-    std::vector<pattern> LastPatList = _PatternList;
-
-    _RasbhariPattern.random_swap_uniq(PatIdx);
-    _PatternList[OrigIdx] = _RasbhariPattern[PatIdx];
-    update(OrigIdx);
-    
-    if(_RasbhariScore < LastCoef){
-        _PatNo = 0;
-        _RasbhariPattern.sort();
-        return true;
+template<typename Objective>
+unsigned rasbhari::_temper(unsigned Limit, bool Report, const Objective & Obj){
+    typedef typename Objective::value_type value_type;
+    unsigned Replicas = std::max(2u, _Threads);
+    double Hottest = _anneal_start(Obj);
+    std::vector<double> Ladder(Replicas, 0);
+    std::vector<unsigned> Holder(Replicas), Rung(Replicas);
+    for(unsigned r = 0; r < Replicas; r++){
+        if(r > 0){
+            Ladder[r] = Hottest*std::pow(1e-3, (double)(Replicas-1-r)/(Replicas-1));
+        }
+        Holder[r] = r;
+        Rung[r] = r;
+    }
+    std::vector<rasbhari> States;
+    States.reserve(Replicas);
+    for(unsigned r = 0; r < Replicas; r++){
+        States.push_back(*this);
+        _Rng.jump();
+        States.back()._Rng = _Rng;
+        States.back()._Threads = 1;
     }
+    std::vector<uint16_t>().swap(_Profiles);
 
-    std::swap(_RasbhariPattern[PatIdx], LastPattern);
-    std::swap(_CoefMat,LastCMat);
-    std::swap(_PatternList,LastPatList);
-    for(auto & Pat : _RasbhariPattern){
-        Pat.set_score(_PatternList[Pat.idx()].score());
+    unsigned Rounds = (Limit + ExchangeInterval - 1)/ExchangeInterval, Round = 0, Ctr = 0;
+    value_type Ground = _score<value_type>();
+    _exchange_barrier Barrier(Replicas);
+    auto Exchange = [&](){
+        for(unsigned l = Round%2; l+1 < Replicas; l += 2){
+            rasbhari & Cold = States[Holder[l]], & Hot = States[Holder[l+1]];
+            double Delta = (double)Cold._score<value_type>() - (double)Hot._score<value_type>();
+            bool Accept = !(Cold._score<value_type>() < Hot._score<value_type>());
+            if(!Accept && Ladder[l] > 0){
+                double Uniform = (_Rng() >> 11)/9007199254740992.0;
+                Accept = Uniform < std::exp((1/Ladder[l] - 1/Ladder[l+1])*Delta);
+            }
+            if(Accept){
+                std::swap(Holder[l], Holder[l+1]);
+                Rung[Holder[l]] = l;
+                Rung[Holder[l+1]] = l+1;
+            }
+        }
+        Round++;
+        if(States[Holder[0]]._score<value_type>() < Ground){
+            Ground = States[Holder[0]]._score<value_type>();
+            Ctr++;
+        }
+        if(Report){
+            std::cout << "\rStep " << std::min(Round*ExchangeInterval, Limit) << "/" << Limit << "  Improvement +" << Ctr;
+            std::cout.flush();
+        }
+    };
+    std::vector<std::thread> Pool;
+    for(unsigned r = 0; r < Replicas; r++){
+        Pool.push_back(std::thread([&, r](){
+            for(unsigned i = 0; i < Rounds; i++){
+                unsigned Steps = std::min(ExchangeInterval, Limit - i*ExchangeInterval);
+                double Temperature = Ladder[Rung[r]];
+                for(unsigned s = 0; s < Steps; s++){
+                    States[r]._climb_hill_anneal(Obj, Temperature);
+                }
+                Barrier.wait(Exchange);
+            }
+        }));
     }
-    _RasbhariScore = LastCoef;
-    _PatNo++;
-    return false;
+    for(auto & Thread : Pool){
+        Thread.join();
+    }
+
+    rasbhari & Winner = States[Holder[0]];
+    _RasbhariScore = Winner._RasbhariScore;
+    _OcScore = Winner._OcScore;
+    std::swap(_RasbhariPattern,Winner._RasbhariPattern);
+    std::swap(_Order,Winner._Order);
+    std::swap(_CoefMat,Winner._CoefMat);
+    std::swap(_OcMat,Winner._OcMat);
+    std::swap(_Profiles,Winner._Profiles);
+    std::swap(_ProfileOffset,Winner._ProfileOffset);
+    return Ctr;
 }
 /**
  * The actuall hillclimbing process. For a specific number, Limit,
@@ -267,33 +1609,98 @@ bool rasbhari::climb_hill(){
  * @return              Returns if an coefficient improvement took place or not.
  */
 bool rasbhari::hill_climbing(unsigned Limit){
-    double ScoreBest = _RasbhariScore, InitialScore = _RasbhariScore;
+    _hill_climbing_call Call;
+    Call.Limit = Limit;
+    return _dispatch(Call);
+}
+/**
+ * The hillclimbing process for a fixed objective policy; the objective is
+ * chosen once for all Limit-many optimising steps. The improve mode is only
+ * read, such that restarts can climb on several threads.
+ * The annealing engine cools down over the Limit steps and keeps the best
+ * set it has passed, which is taken at the end; the tempering engine runs
+ * Limit steps on each of its replicas. The tabu engine counts skipped steps
+ * as well.
+ *
+ * @param Limit         The number of permutation tries executed on the pattern
+ *                          set.
+ *
+ * @param Obj           The objective policy, OC or variance.
+ *
+ * @return              Returns if an coefficient improvement took place or not.
+ */
+template<typename Objective>
+bool rasbhari::_hill_climbing(unsigned Limit, const Objective & Obj){
+    typedef typename Objective::value_type value_type;
+    const value_type & Score = _score<value_type>();
+    value_type ScoreBest = Score, InitialScore = Score;
     _PatNo = 0;
-    unsigned ModeSave = rasb_opt::ImproveMode, Ctr = 0;
-    if(rasb_opt::ImproveMode < 1 || (rasb_opt::OptOc <= 1 && rasb_opt::Sens == false)){
-        rasb_opt::ImproveMode = 1;
+    unsigned Mode = _State.ImproveMode, Ctr = 0;
+    bool Steepest = _Config.Engine == "steepest", Anneal = _Config.Engine == "anneal";
+    if(Mode < 1 || (_Config.OptOc <= 1 && _State.Sens == false)){
+        Mode = 1;
+    }
+    if(_Config.Engine == "temper"){
+        Ctr = _temper(Limit, !_Config.Silent && Mode == 1, Obj);
+        Limit = 0;
+    }
+    bool Tabu = _Config.Engine == "tabu";
+    static thread_local _tabu_memory Memory;
+    if(Tabu){
+        Memory.reset(_RasbhariPattern.size(), Limit, _Config.Tenure);
+        Memory.insert(_RasbhariPattern.hash());
+    }
+    static thread_local patternset AnnealBest;
+    value_type AnnealScore = Score;
+    _anneal_schedule Schedule(_Config, Anneal && Limit > 0 ? _anneal_start(Obj) : 0, Limit);
+    if(Anneal){
+        AnnealBest = _RasbhariPattern;
     }
     for(unsigned i = 0; i < Limit; i++){
-        if(!rasb_opt::Silent && rasb_opt::ImproveMode == 1){
+        if(!_Config.Silent && Mode == 1){
             std::cout << "\rStep " << i << "/" << Limit << "  Improvement +" << Ctr;
             std::cout.flush();
         }
-        climb_hill();
-        if(ScoreBest > _RasbhariScore && !rasb_opt::Silent && rasb_opt::ImproveMode == 1){
-            ScoreBest = _RasbhariScore;
+        if(Steepest){
+            _climb_hill_steepest(Obj);
+            if(_PatNo >= _RasbhariPattern.size()){
+                break;
+            }
+        }
+        else if(Anneal){
+            _climb_hill_anneal(Obj, Schedule.Temperature);
+            bool Better = Score < AnnealScore;
+            if(Better){
+                AnnealScore = Score;
+                AnnealBest = _RasbhariPattern;
+            }
+            Schedule.next(Better);
+        }
+        else if(Tabu){
+            _climb_hill_tabu(Obj, Memory);
+        }
+        else{
+            _climb_hill(Obj);
+        }
+        if(ScoreBest > Score && !_Config.Silent && Mode == 1){
+            ScoreBest = Score;
             Ctr++;
-            if(!rasb_opt::Silent && !rasb_opt::Quiet && rasb_opt::ImproveMode == 1){
+            if(!_Config.Silent && !_Config.Quiet && Mode == 1){
                 std::cout << std::endl;
                 print();
             }
         }
     }
-    if(!rasb_opt::Silent && rasb_opt::ImproveMode == 1){
+    if(Anneal && AnnealScore < Score){
+        _RasbhariPattern = AnnealBest;
+        _make_order();
+        calculate();
+    }
+    if(!_Config.Silent && Mode == 1){
         std::cout << "\r"<< std::string(80,' ') << "\r";
         std::cout << "Number of improvements: " << Ctr << std::endl << std::endl;
     }
-    rasb_opt::ImproveMode = ModeSave;
-    return InitialScore > _RasbhariScore;
+    return InitialScore > Score;
 }   
 /**
  * The iterative hillclimbing process. For a specific number, Limit,
@@ -301,6 +1708,8 @@ bool rasbhari::hill_climbing(unsigned Limit){
  * sets.
  * Thus, in each of the Iteration-many steps, a random patternset is generated,
  * the best of all is taken.
+ * The tempering engine uses the threads for its replicas, then the restarts
+ * run one after another.
  *
  * @param Limit         The number of permutation tries executed on the pattern
  *                          set.
@@ -310,49 +1719,212 @@ bool rasbhari::hill_climbing(unsigned Limit){
  * @return              Returns if an coefficient improvement took place or not.
  */
 bool rasbhari::iterate_hill_climbing(unsigned Limit, unsigned Iteration){
-    patternset HillClimbBest = _RasbhariPattern;
-    std::vector<pattern> PatListBest = _PatternList;
-    std::vector< std::vector<double> > CoefBest = _CoefMat;
-    double ScoreBest = _RasbhariScore, InitialScore = ScoreBest;
-    unsigned ModeSave = rasb_opt::ImproveMode, Ctr = 0;
-    if(rasb_opt::ImproveMode < 2 || rasb_opt::Sens == false){
-        rasb_opt::ImproveMode = 2;
-    }
-    if(rasb_opt::Sens == true && Iteration == 0){
+    double InitialScore = _RasbhariScore;
+    rasbhari_compute::oc_int InitialOcScore = _OcScore;
+    unsigned ModeSave = _State.ImproveMode, Ctr = 0;
+    if(_State.ImproveMode < 2 || _State.Sens == false){
+        _State.ImproveMode = 2;
+    }
+    if(_State.Sens == true && Iteration == 0){
         Iteration = 1;
     }
-    for(unsigned i = 0; i < Iteration; i++){
-        if(!rasb_opt::Silent && rasb_opt::ImproveMode == 2){
+    unsigned Workers = _Config.Engine == "temper" ? 1 : std::min(_Threads, Iteration);
+    _elite_pool Elite(_Config.Elite);
+    if(Workers > 1){
+        Ctr = _restart_pool(Limit, Iteration, Workers, Elite);
+    }
+    else{
+        Ctr = _restarts(Limit, Iteration, 0, 1, nullptr, Elite);
+    }
+    if(!_Config.Silent && _State.ImproveMode == 2){
+        std::cout << "\r"<<  std::string(80,' ') << "\r";
+        std::cout << "Number of improvements: " << Ctr << std::endl << std::endl;
+    }
+    _State.ImproveMode = ModeSave;
+    if(_exact()){
+        return InitialOcScore > _OcScore;
+    }
+    return InitialScore > _RasbhariScore;
+}
+/**
+ * The restarts of the iterative hillclimbing process. The restarts First,
+ * First+Stride, ... below Iteration are done; the best set of them and of
+ * the current set is kept.
+ * With an elite pool the best distinct sets of the restarts are kept;
+ * once the pool is full, each restart starts from a crossover of two sets of
+ * the pool instead of a random set. On several threads all workers share
+ * the pool.
+ *
+ * @param Limit         The number of permutation tries executed on the pattern
+ *                          set.
+ *
+ * @param Iteration     The number of random intial pattern sets.
+ *
+ * @param First         The first restart done by this instance.
+ *
+ * @param Stride        The distance between the restarts of this instance.
+ *
+ * @param Done          The counter of all finished restarts, if the restarts
+ *                          run on several threads; nullptr, if the
+ *                          progress is printed by this instance.
+ *
+ * @param Elite         The elite pool of the restarts.
+ *
+ * @return              The number of improvements.
+ */
+unsigned rasbhari::_restarts(unsigned Limit, unsigned Iteration, unsigned First, unsigned Stride, std::atomic<unsigned> * Done, _elite_pool & Elite){
+    patternset HillClimbBest = _RasbhariPattern;
+    std::vector<unsigned> OrderBest = _Order;
+    coefmatrix<double> CoefBest = _CoefMat;
+    coefmatrix<rasbhari_compute::oc_int> OcBest = _OcMat;
+    double ScoreBest = _RasbhariScore;
+    rasbhari_compute::oc_int OcScoreBest = _OcScore;
+    unsigned Ctr = 0;
+    bool Exact = _exact(), Report = Done == nullptr;
+    static thread_local patternset Parent1, Parent2;
+    for(unsigned i = First; i < Iteration; i += Stride){
+        if(Report && !_Config.Silent && _State.ImproveMode == 2){
             std::cout << "\rStep " << i << "/" << Iteration << "  Improvement +" << Ctr;
             std::cout.flush();
         }
-        _RasbhariPattern = patternset(rasb_opt::Size,rasb_opt::Weight,rasb_opt::Weight,rasb_opt::MinDontcare,rasb_opt::MaxDontcare,true);
-        _make_pattern_list();
+        if(!Elite.pick(_Rng, Parent1, Parent2) || !_crossover(Parent1, Parent2)){
+            _RasbhariPattern.random(_Config.Size,_Config.Weight,_Config.Weight,_Config.MinDontcare,_Config.MaxDontcare,false,_Rng);
+        }
+        _make_order();
         _adjust_coef_mat();
         calculate();
         hill_climbing(Limit);
-        if(ScoreBest > _RasbhariScore){
+        Elite.offer(_RasbhariPattern, _RasbhariScore, _OcScore, Exact);
+        if(Exact ? OcScoreBest > _OcScore : ScoreBest > _RasbhariScore){
             Ctr++;
-            if(!rasb_opt::Silent && !rasb_opt::Quiet && rasb_opt::ImproveMode == 2){
+            if(Report && !_Config.Silent && !_Config.Quiet && _State.ImproveMode == 2){
                 std::cout << std::endl;
                 print();
             }
             ScoreBest = _RasbhariScore;
+            OcScoreBest = _OcScore;
             std::swap(HillClimbBest,_RasbhariPattern);
-            std::swap(PatListBest,_PatternList);
+            std::swap(OrderBest,_Order);
             std::swap(CoefBest,_CoefMat);
+            std::swap(OcBest,_OcMat);
+        }
+        if(Done){
+            (*Done)++;
         }
     }
-    if(!rasb_opt::Silent && rasb_opt::ImproveMode == 2){
-        std::cout << "\r"<<  std::string(80,' ') << "\r";
-        std::cout << "Number of improvements: " << Ctr << std::endl << std::endl;
-    }
-    rasb_opt::ImproveMode = ModeSave;
     _RasbhariScore = ScoreBest;
+    _OcScore = OcScoreBest;
     std::swap(_RasbhariPattern,HillClimbBest);
-    std::swap(_PatternList,PatListBest);
+    std::swap(_Order,OrderBest);
     std::swap(_CoefMat,CoefBest);
-    return InitialScore > _RasbhariScore;
+    std::swap(_OcMat,OcBest);
+    _fill_profiles();
+    return Ctr;
+}
+/**
+ * Creates the start set of a memetic restart by crossover of two sets of the
+ * elite pool. Each pattern is taken from one of the two sets at random, the
+ * pattern at the same index; as the random sets are ordered by weight and
+ * length, the new set keeps their distribution. If the pattern is already
+ * in the new set, the pattern of the other set is taken, if this one is
+ * also there, random patterns of the same weight and length are drawn until
+ * one is unique. The new set replaces the current set and keeps its limits
+ * of weight and don't care positions.
+ *
+ * @param First         The first set of the elite pool.
+ *
+ * @param Second        The second set of the elite pool.
+ *
+ * @return              False, if no unique pattern was found within
+ *                          MaxCrossoverTries draws; then the restart starts
+ *                          from a random set instead.
+ */
+bool rasbhari::_crossover(const patternset & First, const patternset & Second){
+    unsigned Size = std::max(First.size(), Second.size());
+    _RasbhariPattern.clear();
+    for(unsigned i = 0; i < Size; i++){
+        bool FromFirst = i < First.size() && (i >= Second.size() || (_Rng() >> 63));
+        const patternset & Other = FromFirst ? Second : First;
+        pattern Pat = FromFirst ? First[i] : Second[i];
+        if(!_RasbhariPattern.is_uniq(Pat) && i < Other.size()){
+            Pat = Other[i];
+        }
+        unsigned Weight = Pat.weight(), DontCare = Pat.dontcare();
+        for(unsigned Try = 0; !_RasbhariPattern.is_uniq(Pat); Try++){
+            if(Try == MaxCrossoverTries){
+                return false;
+            }
+            Pat.random(Weight, DontCare, _Rng);
+        }
+        _RasbhariPattern.push_back(Pat);
+    }
+    return true;
+}
+/**
+ * Runs the restarts of the iterative hillclimbing process on several
+ * threads. Each worker owns a copy of this instance with its own random
+ * stream, which is split off the stream of this instance by jumps, and does
+ * every Workers-th restart; the calculation of a worker uses a single thread.
+ * Afterwards the best set of all workers is taken, on equal scores the one of
+ * the first worker, such that a seeded run can be repeated with the same
+ * number of threads; with an elite pool the crossovers depend on the order,
+ * in which the workers fill the shared pool.
+ *
+ * @param Limit         The number of permutation tries executed on the pattern
+ *                          set.
+ *
+ * @param Iteration     The number of random intial pattern sets.
+ *
+ * @param Workers       The number of threads.
+ *
+ * @param Elite         The elite pool shared by the workers.
+ *
+ * @return              The number of improvements of all workers.
+ */
+unsigned rasbhari::_restart_pool(unsigned Limit, unsigned Iteration, unsigned Workers, _elite_pool & Elite){
+    std::vector<uint16_t>().swap(_Profiles);
+    std::vector<rasbhari> States;
+    States.reserve(Workers);
+    for(unsigned w = 0; w < Workers; w++){
+        States.push_back(*this);
+        _Rng.jump();
+        States.back()._Rng = _Rng;
+        States.back()._Threads = 1;
+    }
+    std::atomic<unsigned> Done(0), Ctr(0);
+    std::vector<std::thread> Pool;
+    for(unsigned w = 0; w < Workers; w++){
+        Pool.push_back(std::thread([&States, &Done, &Ctr, &Elite, Limit, Iteration, Workers, w](){
+            Ctr += States[w]._restarts(Limit, Iteration, w, Workers, &Done, Elite);
+        }));
+    }
+    if(!_Config.Silent && _State.ImproveMode == 2){
+        for(unsigned Finished = Done; Finished < Iteration; Finished = Done){
+            std::cout << "\rStep " << Finished << "/" << Iteration << "  Improvement +" << Ctr;
+            std::cout.flush();
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+    for(auto & Thread : Pool){
+        Thread.join();
+    }
+    bool Exact = _exact();
+    unsigned Best = 0;
+    for(unsigned w = 1; w < Workers; w++){
+        if(Exact ? States[Best]._OcScore > States[w]._OcScore : States[Best]._RasbhariScore > States[w]._RasbhariScore){
+            Best = w;
+        }
+    }
+    rasbhari & Winner = States[Best];
+    _RasbhariScore = Winner._RasbhariScore;
+    _OcScore = Winner._OcScore;
+    std::swap(_RasbhariPattern,Winner._RasbhariPattern);
+    std::swap(_Order,Winner._Order);
+    std::swap(_CoefMat,Winner._CoefMat);
+    std::swap(_OcMat,Winner._OcMat);
+    std::swap(_Profiles,Winner._Profiles);
+    std::swap(_ProfileOffset,Winner._ProfileOffset);
+    return Ctr;
 }
 /**
  * The iterative hillclimbing process with sensitivity calculation. For a
@@ -389,7 +1961,9 @@ bool rasbhari::climb_hill_sensitivity(unsigned Limit, unsigned Iteration, bool I
  * Thus, in each of the Iteration-many steps, a random patternset is generated,
  * the best of all is taken.
  * These steps are don Loop-many times, the sensitivity of all sets is
- * calculated and the set with highest sensitivity will be returned.
+ * calculated and the set with highest sensitivity will be returned. The
+ * loops run on the threads like the restarts, the tempering engine uses the
+ * threads for its replicas.
  *
  * @param Limit         The number of permutation tries executed on the pattern
  *                          set.
@@ -398,69 +1972,194 @@ bool rasbhari::climb_hill_sensitivity(unsigned Limit, unsigned Iteration, bool I
  *
  * @param Loop          The number of pattern sets for which the sensitivity
  *                          should be calculated. Each pattern set is the best
- *                          of Iteration-many optimised pattern sets.
+ *                          of Iteration-many optimised pattern sets; 0
+ *                          takes the OptSens of the run state, which is
+ *                          reduced to 1, if the sensitivity is too costly.
  *
  * @return              Returns if an coefficient improvement took place or not.
  */
 bool rasbhari::hill_climbing_sensitivity(unsigned Limit, unsigned Iteration, unsigned Loop){
+    if(Loop == 0){
+        Loop = _State.OptSens;
+    }
+    double InitialSens = _RasbhariSensitivity;
+    unsigned ModeSave = _State.ImproveMode, Ctr = 0;
+    if(_State.ImproveMode < 3 && _State.Sens){
+        _State.ImproveMode = 3;
+    }
+    unsigned Workers = _Config.Engine == "temper" ? 1 : std::min(_Threads, Loop);
+    if(Workers > 1){
+        Ctr = _sensitivity_pool(Limit, Iteration, Loop, Workers);
+    }
+    else{
+        Ctr = _sensitivity_loops(Limit, Iteration, Loop, 0, 1, nullptr);
+    }
+    if(!_Config.Silent && _State.ImproveMode == 3){
+        std::cout << "\r" << std::string(80,' ') << "\r";
+        std::cout << "Number of improvements: " << Ctr << std::endl << std::endl;
+    }
+    _State.ImproveMode = ModeSave;
+    return InitialSens < _RasbhariSensitivity;
+}
+/**
+ * The loops of the sensitivity optimisation. The loops First, First+Stride,
+ * ... below Loop are done; the set of highest sensitivity of them and of
+ * the current set is kept.
+ *
+ * @param Limit         The number of permutation tries executed on the pattern
+ *                          set.
+ *
+ * @param Iteration     The number of random intial pattern sets.
+ *
+ * @param Loop          The number of pattern sets for which the sensitivity
+ *                          should be calculated.
+ *
+ * @param First         The first loop done by this instance.
+ *
+ * @param Stride        The distance between the loops of this instance.
+ *
+ * @param Done          The counter of all finished loops, if the loops run
+ *                          on several threads; nullptr, if the progress is
+ *                          printed by this instance.
+ *
+ * @return              The number of improvements.
+ */
+unsigned rasbhari::_sensitivity_loops(unsigned Limit, unsigned Iteration, unsigned Loop, unsigned First, unsigned Stride, std::atomic<unsigned> * Done){
     patternset HillClimbBest = _RasbhariPattern;
-    std::vector<pattern> PatListBest = _PatternList;
-    std::vector< std::vector<double> > CoefBest = _CoefMat;
-    double SensBest = _RasbhariSensitivity, InitialSens = _RasbhariSensitivity;
+    std::vector<unsigned> OrderBest = _Order;
+    coefmatrix<double> CoefBest = _CoefMat;
+    coefmatrix<rasbhari_compute::oc_int> OcBest = _OcMat;
+    double SensBest = _RasbhariSensitivity;
+    double ScoreBest = _RasbhariScore;
+    rasbhari_compute::oc_int OcScoreBest = _OcScore;
     unsigned Ctr = 0;
-    unsigned ModeSave = rasb_opt::ImproveMode;
-    if(rasb_opt::ImproveMode < 3 && rasb_opt::Sens){
-        rasb_opt::ImproveMode = 3;
-    }
-    for(unsigned i = 0; i < Loop; i++){
-        if(!rasb_opt::Silent && rasb_opt::ImproveMode == 3){
+    bool Report = Done == nullptr;
+    for(unsigned i = First; i < Loop; i += Stride){
+        if(Report && !_Config.Silent && _State.ImproveMode == 3){
             std::cout << "\rStep " << i << "/" << Loop << "  Improvement +" << Ctr;
             std::cout.flush();
         }
-        _RasbhariPattern = patternset(rasb_opt::Size,rasb_opt::Weight,rasb_opt::Weight,rasb_opt::MinDontcare,rasb_opt::MaxDontcare,true);
-        _make_pattern_list();
+        _RasbhariPattern.random(_Config.Size,_Config.Weight,_Config.Weight,_Config.MinDontcare,_Config.MaxDontcare,false,_Rng);
+        _make_order();
         _adjust_coef_mat();
         calculate();
         climb_hill_sensitivity(Limit, Iteration);
         if(SensBest < _RasbhariSensitivity){
             Ctr++;
-            if(!rasb_opt::Silent && !rasb_opt::Quiet && rasb_opt::ImproveMode == 3){
+            if(Report && !_Config.Silent && !_Config.Quiet && _State.ImproveMode == 3){
                 std::cout << std::endl;
                 print();
             }
             SensBest = _RasbhariSensitivity;
+            ScoreBest = _RasbhariScore;
+            OcScoreBest = _OcScore;
             std::swap(HillClimbBest,_RasbhariPattern);
-            std::swap(PatListBest,_PatternList);
+            std::swap(OrderBest,_Order);
             std::swap(CoefBest,_CoefMat);
+            std::swap(OcBest,_OcMat);
+        }
+        if(Done){
+            (*Done)++;
         }
     }
-    if(!rasb_opt::Silent && rasb_opt::ImproveMode == 3){
-        std::cout << "\r" << std::string(80,' ') << "\r";
-        std::cout << "Number of improvements: " << Ctr << std::endl << std::endl;
-    }
-    rasb_opt::ImproveMode = ModeSave;
     _RasbhariSensitivity = SensBest;
+    _RasbhariScore = ScoreBest;
+    _OcScore = OcScoreBest;
     std::swap(_RasbhariPattern,HillClimbBest);
-    std::swap(_PatternList,PatListBest);
+    std::swap(_Order,OrderBest);
     std::swap(_CoefMat,CoefBest);
-    return InitialSens < _RasbhariSensitivity;
+    std::swap(_OcMat,OcBest);
+    _fill_profiles();
+    return Ctr;
+}
+/**
+ * Runs the loops of the sensitivity optimisation on several threads. Each
+ * worker owns a copy of this instance with its own random stream, like the
+ * workers of the restarts, and does every Workers-th loop with serial
+ * restarts. Afterwards the set of highest sensitivity of all workers is
+ * taken, on equal sensitivities the one of the first worker. If the
+ * sensitivity was turned off by a worker, it is turned off for this
+ * instance as well.
+ *
+ * @param Limit         The number of permutation tries executed on the pattern
+ *                          set.
+ *
+ * @param Iteration     The number of random intial pattern sets.
+ *
+ * @param Loop          The number of pattern sets for which the sensitivity
+ *                          should be calculated.
+ *
+ * @param Workers       The number of threads.
+ *
+ * @return              The number of improvements of all workers.
+ */
+unsigned rasbhari::_sensitivity_pool(unsigned Limit, unsigned Iteration, unsigned Loop, unsigned Workers){
+    std::vector<uint16_t>().swap(_Profiles);
+    std::vector<rasbhari> States;
+    States.reserve(Workers);
+    for(unsigned w = 0; w < Workers; w++){
+        States.push_back(*this);
+        _Rng.jump();
+        States.back()._Rng = _Rng;
+        States.back()._Threads = 1;
+        States.back()._State.SensPrinted = true;
+    }
+    std::atomic<unsigned> Done(0), Ctr(0);
+    std::vector<std::thread> Pool;
+    for(unsigned w = 0; w < Workers; w++){
+        Pool.push_back(std::thread([&States, &Done, &Ctr, Limit, Iteration, Loop, Workers, w](){
+            Ctr += States[w]._sensitivity_loops(Limit, Iteration, Loop, w, Workers, &Done);
+        }));
+    }
+    if(!_Config.Silent && _State.ImproveMode == 3){
+        for(unsigned Finished = Done; Finished < Loop; Finished = Done){
+            std::cout << "\rStep " << Finished << "/" << Loop << "  Improvement +" << Ctr;
+            std::cout.flush();
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+    for(auto & Thread : Pool){
+        Thread.join();
+    }
+    unsigned Best = 0;
+    for(unsigned w = 0; w < Workers; w++){
+        if(States[Best]._RasbhariSensitivity < States[w]._RasbhariSensitivity){
+            Best = w;
+        }
+        _State.Sens = _State.Sens && States[w]._State.Sens;
+        _State.Forcesens = _State.Forcesens && States[w]._State.Forcesens;
+        _State.OptSens = std::min(_State.OptSens, States[w]._State.OptSens);
+    }
+    rasbhari & Winner = States[Best];
+    _RasbhariSensitivity = Winner._RasbhariSensitivity;
+    _RasbhariScore = Winner._RasbhariScore;
+    _OcScore = Winner._OcScore;
+    std::swap(_RasbhariPattern,Winner._RasbhariPattern);
+    std::swap(_Order,Winner._Order);
+    std::swap(_CoefMat,Winner._CoefMat);
+    std::swap(_OcMat,Winner._OcMat);
+    std::swap(_Profiles,Winner._Profiles);
+    std::swap(_ProfileOffset,Winner._ProfileOffset);
+    return Ctr;
 }
 
 
 /**
- * Returns the pattern set optimised by rasbhari conditions.
+ * Returns the pattern set optimised by rasbhari conditions; the patterns are
+ * ordered by their contribution.
  *
  * @return              The optimised pattern set
  */
 patternset rasbhari::pattern_set() const{
-    return _RasbhariPattern;
+    return _ordered_set();
 }
 /**
- * Returns the pattern set (Reference) optimised by rasbhari conditions.
+ * Returns the pattern set (constant Reference) optimised by rasbhari
+ * conditions; the patterns are in the order of their indices.
  *
  * @return              The optimised pattern set
  */
-patternset & rasbhari::pattern_set(){
+const patternset & rasbhari::pattern_set(){
     return _RasbhariPattern;
 }
 
@@ -481,6 +2180,40 @@ double rasbhari::sensitivity() const{
     return _RasbhariSensitivity;
 }
 
+/**
+ * Checks, if an objective is in the registry.
+ *
+ * @param Name          The name of the objective.
+ *
+ * @return              True, if the objective exists.
+ */
+bool rasbhari::is_objective(const std::string & Name){
+    return _find_objective<_exact_call>(Name) != nullptr;
+}
+/**
+ * Returns the label of an objective, e.g. for the printed parameters.
+ *
+ * @param Name          The name of the objective.
+ *
+ * @return              The label, empty if the objective is unknown.
+ */
+std::string rasbhari::objective_label(const std::string & Name){
+    const _objective<_exact_call> * Objective = _find_objective<_exact_call>(Name);
+    return Objective ? Objective->Label : "";
+}
+/**
+ * Checks, if an objective counts overlaps like the overlap complexity; then
+ * the default pattern lengths of the overlap complexity are used.
+ *
+ * @param Name          The name of the objective.
+ *
+ * @return              True, if the objective is overlap complexity like.
+ */
+bool rasbhari::overlap_objective(const std::string & Name){
+    const _objective<_exact_call> * Objective = _find_objective<_exact_call>(Name);
+    return Objective && Objective->Overlap;
+}
+
 /**
  * Returns the pattern set size.
  *
@@ -495,12 +2228,12 @@ unsigned rasbhari::size() const{
  * Prints all relevant information about the pattern set to std::cout.
  */
 void rasbhari::print(){
-    for(auto Pat : _RasbhariPattern){
-        std::cout << Pat.idx() << " " << Pat.to_string() << std::endl;
+    for(unsigned Idx : _Order){
+        std::cout << Idx << " " << _RasbhariPattern[Idx].to_string() << std::endl;
     }
     std::cout << "rasbhari coefficient        : " << _RasbhariScore << std::endl;
     std::cout << "rasbhari coefficient (norm) : " << _RasbhariScore / ((_RasbhariPattern.size()*(_RasbhariPattern.size()+1))/(double)2) << std::endl;
-    if(rasb_opt::Sens){
+    if(_State.Sens){
         std::cout << "rasbhari sensitivity        : " << _RasbhariSensitivity << std::endl;
     }
     std::cout << std::endl;
@@ -515,15 +2248,15 @@ void rasbhari::to_file(std::string OutFile){
     if(OutFile.size() == 0){
         return;
     }
-    _RasbhariPattern.to_file(OutFile);
+    _ordered_set().to_file(OutFile);
     std::ofstream Output(OutFile, std::ios::app);
     Output << "#rasbhari coefficient        : " << _RasbhariScore << std::endl;
     Output << "#rasbhari coefficient (norm) : " << _RasbhariScore / ((_RasbhariPattern.size()*(_RasbhariPattern.size()+1))/(double)2) << std::endl;
-    if(rasb_opt::Sens){
+    if(_State.Sens){
         Output << "#rasbhari sensitivity        : " << _RasbhariSensitivity << std::endl;
     }
     Output.close();
-    if(!rasb_opt::Silent){
+    if(!_Config.Silent){
         std::cout << "rasbhari set written to file:\n    '" << OutFile << "'" << std::endl;
     }
 }
@@ -537,19 +2270,8 @@ void rasbhari::to_file(std::string OutFile){
  *
  * @return              The pattern from the Idx-th position; constant
  */
-pattern rasbhari::operator[](size_t Idx) const{
-    return _PatternList[Idx];
-}
-/**
- * Random access operator, that returns the pattern from a specific
- * position in the rasbhari set.
- *
- * @param Idx           The index number of a pattern, that sould be returned.
- *
- * @return              The pattern from the Idx-th position; r-value
- */
-pattern & rasbhari::operator[](size_t Idx){
-    return _PatternList[Idx];
+const pattern & rasbhari::operator[](size_t Idx) const{
+    return _RasbhariPattern[Idx];
 }
 
 /**
@@ -558,8 +2280,8 @@ pattern & rasbhari::operator[](size_t Idx){
  *
  * @return              Begin-Iterator for the pattern set.
  */
-rasbhari::iterator rasbhari::begin(){
-    return _PatternList.begin();
+rasbhari::const_iterator rasbhari::begin() const{
+    return _RasbhariPattern.begin();
 }
 /**
  * An end iterator is returned, that can be used to iterate over the pattern
@@ -567,8 +2289,8 @@ rasbhari::iterator rasbhari::begin(){
  *
  * @return              End-Iterator for the pattern set.
  */
-rasbhari::iterator rasbhari::end(){
-    return _PatternList.end();
+rasbhari::const_iterator rasbhari::end() const{
+    return _RasbhariPattern.end();
 }
 
 
@@ -576,24 +2298,39 @@ rasbhari::iterator rasbhari::end(){
  * Some Debug information, this is not for your concern.
  */
 void rasbhari::_debug(){
-    std::cout << "RasbPat Score Idx\tListPat Score Idx\t\tpairwise idx identic?" << std::endl;
-    for(unsigned i = 0; i < _RasbhariPattern.size(); i++){
-        std::cout << _RasbhariPattern[i].to_string() << " " << _RasbhariPattern[i].score() << " " << _RasbhariPattern[i].idx() << " \t";
-        std::cout << _PatternList[i].to_string() << " " << _PatternList[i].score() << " " << _PatternList[i].idx() << std::endl;
+    std::cout << "Order\tRasbPat Score Idx" << std::endl;
+    for(unsigned i = 0; i < _Order.size(); i++){
+        const pattern & Pat = _RasbhariPattern[_Order[i]];
+        std::cout << i << "\t" << Pat.to_string() << " " << Pat.score() << " " << Pat.idx() << std::endl;
     }
     std::cout << std::endl;
     std::cout << "Coef Mat " << _RasbhariPattern.size() << "x" << _RasbhariPattern.size() << "\tSymmetric?" << std::endl;
-    for(unsigned i = 0; i < _PatternList.size(); i++){
-        for(unsigned j = 0; j < _PatternList.size(); j++){
-            std::cout << _CoefMat[i][j] << " ";
+    for(unsigned i = 0; i < _RasbhariPattern.size(); i++){
+        for(unsigned j = 0; j < _RasbhariPattern.size(); j++){
+            std::cout << (_exact() ? (double)_OcMat.get(i,j) : _CoefMat.get(i,j)) << " ";
         }
         std::cout << std::endl;
     }
     std::cout << std::endl;
-    std::cout << "_RasbhariScore: " << _RasbhariScore/((rasb_opt::Size*(rasb_opt::Size+1))/2) << std::endl;
+    std::cout << "_RasbhariScore: " << _RasbhariScore/((_Config.Size*(_Config.Size+1))/2) << std::endl;
     std::cout << "_RasbhariSensitivity: " << _RasbhariSensitivity << std::endl << std::endl << std::endl;
 }
 
+/**
+ * Creates the random stream of a new instance; it is seeded by '--seed', if
+ * set, such that runs can be repeated, otherwise from the random device.
+ *
+ * @param Config        The configuration of the instance.
+ *
+ * @return              The random stream.
+ */
+rng rasbhari::_make_rng(const rasb_opt::config & Config){
+    if(Config.SetSeed){
+        return rng(Config.Seed);
+    }
+    return rng();
+}
+
 /**
  * Calculates for minimal and maximal DC positions with its weight and pattern
  * set number the maximal possible number of unique patterns. If the number is
@@ -607,7 +2344,6 @@ void rasbhari::_check_pattern_number(unsigned & Size, unsigned Weight, unsigned
         std::cerr << "The number of patterns will be adjusted to " << MaxPatNo << " patterns!" << std::endl << std::endl;
         printf("%c[0m", 27);
         Size = (unsigned)MaxPatNo;
-        rasb_opt::Size = (unsigned)MaxPatNo;
     }
 }
 /**
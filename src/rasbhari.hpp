@@ -22,26 +22,45 @@
 #ifndef RASBHARI_HPP_
 #define RASBHARI_HPP_
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <ios>
 #include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include "coefmatrix.hpp"
 #include "patternset.hpp"
 #include "pattern.hpp"
 #include "rasbcomp.hpp"
 #include "rasbopt.hpp"
+#include "rng.hpp"
 
 /**
  * An object/instance of the rasbhari class represents and contains depending
  * on the actions an optimised patternsets with its OC/Variance score, the
  * sensitivity and other necessary information.
  * Iterators can be used to iterate over the rasbhari patternset.
+ *
+ * Each instance keeps its own copy of the configuration and its own run
+ * state, the global options are only read when it is created; instances can
+ * be optimised on different threads at once.
  */
 class rasbhari{
     public:
-        rasbhari();
-        rasbhari(const rasbhari &RasbObj);
-        rasbhari(unsigned Size, unsigned Weight, unsigned DontCare);
-        rasbhari(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare);
-        rasbhari(std::string PatternFile);
+        rasbhari(const rasb_opt::config & Config = rasb_opt::config());
+        rasbhari(const rasbhari &RasbObj) = default;
+        rasbhari(rasbhari &&RasbObj) = default;
+        rasbhari & operator=(const rasbhari &RasbObj) = default;
+        rasbhari & operator=(rasbhari &&RasbObj) = default;
+        rasbhari(unsigned Size, unsigned Weight, unsigned DontCare, const rasb_opt::config & Config = rasb_opt::config());
+        rasbhari(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare, const rasb_opt::config & Config = rasb_opt::config());
+        rasbhari(std::string PatternFile, const rasb_opt::config & Config = rasb_opt::config());
 
         void push_back(pattern & Pat);
         void push_back(pattern && Pat);
@@ -51,39 +70,132 @@ class rasbhari{
         void calculate_sensitivity();
         void update(unsigned Idx);
         bool climb_hill();
+        bool climb_hill_steepest();
+        bool climb_hill_anneal(double Temperature);
         bool hill_climbing(unsigned Limit = rasb_opt::Limit);
         bool iterate_hill_climbing(unsigned Limit = rasb_opt::Limit, unsigned Iteration = rasb_opt::OptOc);
         bool climb_hill_sensitivity(unsigned Limit = rasb_opt::Limit, unsigned Iteration = rasb_opt::OptOc, bool InitSens = true);
-        bool hill_climbing_sensitivity(unsigned Limit = rasb_opt::Limit, unsigned Iteration = rasb_opt::OptOc, unsigned Loop = rasb_opt::OptSens);
+        bool hill_climbing_sensitivity(unsigned Limit = rasb_opt::Limit, unsigned Iteration = rasb_opt::OptOc, unsigned Loop = 0);
 
         patternset pattern_set() const;
-        patternset & pattern_set();
+        const patternset & pattern_set();
         double score() const;
         double sensitivity() const;
         unsigned size() const;
         void print();
         void to_file(std::string OutFile = rasb_opt::OutFile);
 
-        pattern operator[](size_t Idx) const;
-        pattern & operator[](size_t Idx);
-        typedef std::vector<pattern>::iterator iterator;
-        iterator begin();
-        iterator end();
+        static bool is_objective(const std::string & Name);
+        static std::string objective_label(const std::string & Name);
+        static bool overlap_objective(const std::string & Name);
+
+        const pattern & operator[](size_t Idx) const;
+        typedef patternset::const_iterator const_iterator;
+        const_iterator begin() const;
+        const_iterator end() const;
 
     private:
+        struct _calculate_call;
+        struct _update_call;
+        struct _climb_hill_call;
+        struct _climb_hill_steepest_call;
+        struct _climb_hill_anneal_call;
+        struct _hill_climbing_call;
+        struct _pair_call;
+        struct _exact_call;
+        template<typename Value>
+        struct _undo_log;
+        struct _anneal_schedule;
+        struct _exchange_barrier;
+        struct _tabu_memory;
+        struct _elite_pool;
+        template<typename Call>
+        struct _objective;
+        template<typename Call>
+        static const std::vector< _objective<Call> > & _objectives();
+        template<typename Call>
+        static const _objective<Call> * _find_objective(const std::string & Name);
+        template<typename Call>
+        typename Call::result_type _dispatch(const Call & C);
+        template<typename Call>
+        typename Call::result_type _dispatch_oc(const Call & C);
+        template<typename Call>
+        typename Call::result_type _dispatch_variance(const Call & C);
+        template<typename Call>
+        typename Call::result_type _dispatch_woc(const Call & C);
+        template<typename Call, typename Objective>
+        typename Call::result_type _dispatch_length(const Call & C, const Objective & Obj);
+
+        template<typename Objective>
+        void _calculate(const Objective & Obj);
+        template<typename Objective>
+        void _calculate_tile(unsigned RowBegin, unsigned ColBegin, bool UseProfiles, const Objective & Obj);
+        template<typename Objective>
+        void _update(unsigned Idx, const Objective & Obj);
+        template<typename Objective>
+        void _update_swap(unsigned Idx, unsigned OffPos, unsigned OnPos, const Objective & Obj);
+        template<typename Value, typename Term>
+        Value _swap_profile(unsigned Idx, unsigned Partner, unsigned OffPos, unsigned OnPos, const Term & T);
+        template<typename Objective>
+        bool _climb_hill(const Objective & Obj);
+        template<typename Objective>
+        bool _climb_hill_steepest(const Objective & Obj);
+        template<typename Objective>
+        bool _climb_hill_anneal(const Objective & Obj, double Temperature);
+        template<typename Objective>
+        double _anneal_start(const Objective & Obj);
+        template<typename Objective>
+        bool _climb_hill_tabu(const Objective & Obj, _tabu_memory & Memory);
+        template<typename Objective>
+        unsigned _temper(unsigned Limit, bool Report, const Objective & Obj);
+        template<typename Objective>
+        bool _hill_climbing(unsigned Limit, const Objective & Obj);
+        unsigned _restarts(unsigned Limit, unsigned Iteration, unsigned First, unsigned Stride, std::atomic<unsigned> * Done, _elite_pool & Elite);
+        unsigned _restart_pool(unsigned Limit, unsigned Iteration, unsigned Workers, _elite_pool & Elite);
+        bool _crossover(const patternset & First, const patternset & Second);
+        unsigned _sensitivity_loops(unsigned Limit, unsigned Iteration, unsigned Loop, unsigned First, unsigned Stride, std::atomic<unsigned> * Done);
+        unsigned _sensitivity_pool(unsigned Limit, unsigned Iteration, unsigned Loop, unsigned Workers);
+        template<typename Value>
+        coefmatrix<Value> & _coef_mat();
+        template<typename Value>
+        Value & _score();
+        const rasbhari_compute::var_table & _var_table();
+        const rasbhari_compute::woc_table & _woc_table();
+        const rasbhari_compute::woc_table & _oc_table();
+        bool _exact();
+        bool _make_profiles();
+        void _fill_profiles();
+        void _make_profile(unsigned Idx1, unsigned Idx2);
+        void _revert_profiles(unsigned Idx, unsigned OffPos, unsigned OnPos);
+
         void _debug();
-        void _make_pattern_list();
+        void _make_order();
+        patternset _ordered_set() const;
+        template<typename Value>
+        void _sort_order(bool Full);
         void _adjust_coef_mat();
+        static rng _make_rng(const rasb_opt::config & Config);
         void _check_pattern_number(unsigned & Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare);
         double _max_pat_no(unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare);
         double _binom_coef(unsigned n, unsigned k);
 
-        std::vector< std::vector<double> > _CoefMat;
-        std::vector<pattern> _PatternList;
+        rasb_opt::config _Config;
+        rasb_opt::run_state _State;
+        coefmatrix<double> _CoefMat;
+        coefmatrix<rasbhari_compute::oc_int> _OcMat;
+        std::vector<unsigned> _Order;
+        std::vector<uint16_t> _Profiles;
+        std::vector<size_t> _ProfileOffset;
         patternset _RasbhariPattern;
+        rasbhari_compute::var_table _VarTable;
+        rasbhari_compute::woc_table _WocTable;
+        rasbhari_compute::woc_table _OcTable;
+        rng _Rng;
         double _RasbhariScore;
+        rasbhari_compute::oc_int _OcScore;
         double _RasbhariSensitivity;
         unsigned long _PatNo;
+        unsigned _Threads;
 };
 
 #endif
\ No newline at end of file
@@ -21,6 +21,67 @@
  */
 #include "rasbimp.hpp"
 
+/**
+ * Creates for patternset-parameters Size, Weight, Min-/MaxDontCare a randomly
+ * initialised patternset, optimises it with rasb_opt::Limit many of random
+ * permutations for the objective of rasb_opt::Objective.
+ *
+ * @param Size          The number of pattern.
+ *
+ * @param Weight        The number of match positions in the patterns, i.e.
+ *                          the weight.
+ *
+ * @param MinDontCare   The minimal number of don't-care positions in the
+ *                          patterns.
+ *
+ * @param MaxDontCare   The maximal number of don't-care positions in the
+ *                          patterns.
+ */
+rasbhari rasb_implement::hillclimb(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare){
+    return _hillclimb(Size, Weight, MinDontCare, MaxDontCare);
+}
+/**
+ * Creates for patternset-parameters Size, Weight, Min-/MaxDontCare
+ * rasb_opt::OptOc many randomly initialised patternsets, optimises them with
+ * rasb_opt::Limit many of random permutations for the objective of
+ * rasb_opt::Objective and takes the best.
+ *
+ * @param Size          The number of pattern.
+ *
+ * @param Weight        The number of match positions in the patterns, i.e.
+ *                          the weight.
+ *
+ * @param MinDontCare   The minimal number of don't-care positions in the
+ *                          patterns.
+ *
+ * @param MaxDontCare   The maximal number of don't-care positions in the
+ *                          patterns.
+ */
+rasbhari rasb_implement::hillclimb_iterative(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare){
+    return _hillclimb_iterative(Size, Weight, MinDontCare, MaxDontCare);
+}
+/**
+ * Chooses for patternset-parameters Size, Weight, Min-/MaxDontCare
+ * rasb_opt::OptSens many patternsets, that are the best of rasb_opt::OptOc
+ * many randomly initialised patternsets, which were optimised for the
+ * objective of rasb_opt::Objective, the patternset with the highest
+ * sensitivity.
+ *
+ * @param Size          The number of pattern.
+ *
+ * @param Weight        The number of match positions in the patterns, i.e.
+ *                          the weight.
+ *
+ * @param MinDontCare   The minimal number of don't-care positions in the
+ *                          patterns.
+ *
+ * @param MaxDontCare   The maximal number of don't-care positions in the
+ *                          patterns.
+ */
+rasbhari rasb_implement::hillclimb_sens(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare){
+    return _hillclimb_sens(Size, Weight, MinDontCare, MaxDontCare);
+}
+
 /**
  * Creates for patternset-parameters Size, Weight, Min-/MaxDontCare a randomly
  * initialised patternset, optimises it with rasb_opt::Limit many of random
@@ -38,7 +99,7 @@
  *                          patterns.
  */
 rasbhari rasb_implement::hillclimb_var(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare){
-    rasb_opt::Oc = false;
+    rasb_opt::set_objective("variance");
     return _hillclimb(Size, Weight, MinDontCare, MaxDontCare);
 }
 /**
@@ -58,7 +119,7 @@ rasbhari rasb_implement::hillclimb_var(unsigned Size, unsigned Weight, unsigned
  *                          patterns.
  */
 rasbhari rasb_implement::hillclimb_oc(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare){
-    rasb_opt::Oc = true;
+    rasb_opt::set_objective("oc");
     return _hillclimb(Size, Weight, MinDontCare, MaxDontCare);
 }
 
@@ -80,7 +141,7 @@ rasbhari rasb_implement::hillclimb_oc(unsigned Size, unsigned Weight, unsigned M
  *                          patterns.
  */
 rasbhari rasb_implement::hillclimb_oc_iterative(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare){
-    rasb_opt::Oc = true;
+    rasb_opt::set_objective("oc");
     return _hillclimb_iterative(Size,Weight,MinDontCare,MaxDontCare);
 }
 /**
@@ -101,7 +162,7 @@ rasbhari rasb_implement::hillclimb_oc_iterative(unsigned Size, unsigned Weight,
  *                          patterns.
  */
 rasbhari rasb_implement::hillclimb_var_iterative(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare){
-    rasb_opt::Oc = false;
+    rasb_opt::set_objective("variance");
     return _hillclimb_iterative(Size,Weight,MinDontCare,MaxDontCare);
 }
 
@@ -124,7 +185,7 @@ rasbhari rasb_implement::hillclimb_var_iterative(unsigned Size, unsigned Weight,
  *                          patterns.
  */
 rasbhari rasb_implement::hillclimb_sens_oc(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare){
-    rasb_opt::Oc = true;
+    rasb_opt::set_objective("oc");
     return _hillclimb_sens(Size,Weight,MinDontCare,MaxDontCare);
 }
 /**
@@ -146,10 +207,78 @@ rasbhari rasb_implement::hillclimb_sens_oc(unsigned Size, unsigned Weight, unsig
  *                          patterns.
  */
 rasbhari rasb_implement::hillclimb_sens_var(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare){
-    rasb_opt::Oc = false;
+    rasb_opt::set_objective("variance");
     return _hillclimb_sens(Size,Weight,MinDontCare,MaxDontCare);
 }
 
+/**
+ * Scores a fixed patternset for many variance parameters without any
+ * optimisation. The overlap histograms are computed once from the patterns of
+ * rasb_opt::InFile or are read from rasb_opt::HistFile; afterwards each
+ * parameter tuple only needs a table lookup per histogram entry. The scores
+ * are printed and written to rasb_opt::OutFile, if set.
+ *
+ * @param RescoreFile   File with one parameter tuple 'p q S' per line; lines
+ *                          starting with '#' are skipped.
+ */
+void rasb_implement::rescore(std::string RescoreFile){
+    overlaphist Hist;
+    if(rasb_opt::InFile.size() != 0){
+        Hist = overlaphist(patternset(rasb_opt::InFile));
+        if(rasb_opt::HistFile.size() != 0){
+            Hist.to_file(rasb_opt::HistFile);
+        }
+    }
+    else if(rasb_opt::HistFile.size() != 0){
+        Hist = overlaphist(rasb_opt::HistFile);
+    }
+    else{
+        std::cerr << "Rescoring needs patterns ('--pattern') or histograms ('--histogram')!" << std::endl;
+        std::exit(-1);
+    }
+
+    std::ifstream Input(RescoreFile);
+    if(!Input.is_open()){
+        std::cerr << "Could not open parameter file '" << RescoreFile << "'!" << std::endl;
+        std::exit(-1);
+    }
+    std::vector<rasbhari_compute::var_table> Tables;
+    std::string Line;
+    while(std::getline(Input, Line)){
+        if(Line.find_first_not_of(" \t\r") == std::string::npos || Line[0] == '#'){
+            continue;
+        }
+        std::istringstream Fields(Line);
+        double P, Q;
+        long SeqLength;
+        if(!(Fields >> P >> Q >> SeqLength) || P <= 0 || P >= 1 || Q <= 0 || Q >= 1 || SeqLength <= 0){
+            std::cerr << "Illegal parameter line '" << Line << "' in '" << RescoreFile << "'!" << std::endl;
+            std::exit(-1);
+        }
+        Tables.push_back(rasbhari_compute::var_table(P, Q, SeqLength, Hist.weight()));
+    }
+    Input.close();
+
+    double Norm = (Hist.size()*(Hist.size()+1))/(double)2;
+    std::ostringstream Output;
+    Output << "#rasbhari overlap complexity        : " << Hist.oc() << std::endl;
+    Output << "#rasbhari overlap complexity (norm) : " << Hist.oc() / Norm << std::endl;
+    Output << "#p\tq\tS\tvariance\tvariance(norm)" << std::endl;
+    for(const rasbhari_compute::var_table & Table : Tables){
+        double Score = Hist.variance(Table);
+        Output << Table.P << "\t" << Table.Q << "\t" << Table.SeqLength << "\t" << Score << "\t" << Score / Norm << std::endl;
+    }
+    std::cout << Output.str();
+    if(rasb_opt::OutFile.size() != 0){
+        std::ofstream OutFile(rasb_opt::OutFile);
+        OutFile << Output.str();
+        OutFile.close();
+        if(!rasb_opt::Silent){
+            std::cout << "rasbhari scores written to file:\n    '" << rasb_opt::OutFile << "'" << std::endl;
+        }
+    }
+}
+
 /**
  * Wrapper for the simple hill-climbing process for the OC/Var; depending 
  * on boolean output variables, some information will be printed to std::cout.
@@ -169,19 +298,16 @@ rasbhari rasb_implement::hillclimb_sens_var(unsigned Size, unsigned Weight, unsi
  * @return              Returns the final rasbhari patternset output.
  */
 rasbhari rasb_implement::_hillclimb(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare){
-    rasb_opt::ImproveMode = 1;
-    rasb_opt::Sens = false;
-    rasbhari RasbSet;
+    rasb_opt::config Config;
+    Config.ImproveMode = 1;
+    Config.Sens = false;
+    rasbhari RasbSet(Config);
     if(rasb_opt::InFile.size() != 0){
-        RasbSet = rasbhari(rasb_opt::InFile);
+        RasbSet = rasbhari(rasb_opt::InFile, Config);
     }
     else{
-        RasbSet = rasbhari(Size,Weight,MinDontCare,MaxDontCare);
+        RasbSet = rasbhari(Size,Weight,MinDontCare,MaxDontCare,Config);
     }
-    rasb_opt::Size = RasbSet.pattern_set().size();
-    rasb_opt::Weight = RasbSet.pattern_set().max_weight();
-    rasb_opt::MinDontcare = RasbSet.pattern_set().min_dontcare();
-    rasb_opt::MaxDontcare = RasbSet.pattern_set().max_dontcare();
     unsigned FillSizeBegin = 0, FillSizeEnd = 0;
     if(MaxDontCare + Weight > 13){
         FillSizeBegin = (MaxDontCare+Weight-13)/2;
@@ -227,19 +353,16 @@ rasbhari rasb_implement::_hillclimb(unsigned Size, unsigned Weight, unsigned Min
  * @return              Returns the final rasbhari patternset output.
  */
 rasbhari rasb_implement::_hillclimb_iterative(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare){
-    rasb_opt::ImproveMode = 2;
-    rasb_opt::Sens = false;
-    rasbhari RasbSet;
+    rasb_opt::config Config;
+    Config.ImproveMode = 2;
+    Config.Sens = false;
+    rasbhari RasbSet(Config);
     if(rasb_opt::InFile.size() != 0){
-        RasbSet = rasbhari(rasb_opt::InFile);
+        RasbSet = rasbhari(rasb_opt::InFile, Config);
     }
     else{
-        RasbSet = rasbhari(Size,Weight,MinDontCare,MaxDontCare);
+        RasbSet = rasbhari(Size,Weight,MinDontCare,MaxDontCare,Config);
     }
-    rasb_opt::Size = RasbSet.pattern_set().size();
-    rasb_opt::Weight = RasbSet.pattern_set().max_weight();
-    rasb_opt::MinDontcare = RasbSet.pattern_set().min_dontcare();
-    rasb_opt::MaxDontcare = RasbSet.pattern_set().max_dontcare();
     unsigned FillSizeBegin = 0, FillSizeEnd = 0;
     if(MaxDontCare + Weight > 13){
         FillSizeBegin = (MaxDontCare+Weight-13)/2;
@@ -285,19 +408,16 @@ rasbhari rasb_implement::_hillclimb_iterative(unsigned Size, unsigned Weight, un
  * @return              Returns the final rasbhari patternset output.
  */
 rasbhari rasb_implement::_hillclimb_sens(unsigned Size, unsigned Weight, unsigned MinDontCare, unsigned MaxDontCare){
-    rasb_opt::ImproveMode = 3;
-    rasb_opt::Sens = true;
-    rasbhari RasbSet;
+    rasb_opt::config Config;
+    Config.ImproveMode = 3;
+    Config.Sens = true;
+    rasbhari RasbSet(Config);
     if(rasb_opt::InFile.size() != 0){
-        RasbSet = rasbhari(rasb_opt::InFile);
+        RasbSet = rasbhari(rasb_opt::InFile, Config);
     }
     else{
-        RasbSet = rasbhari(Size,Weight,MinDontCare,MaxDontCare);
+        RasbSet = rasbhari(Size,Weight,MinDontCare,MaxDontCare,Config);
     }
-    rasb_opt::Size = RasbSet.pattern_set().size();
-    rasb_opt::Weight = RasbSet.pattern_set().max_weight();
-    rasb_opt::MinDontcare = RasbSet.pattern_set().min_dontcare();
-    rasb_opt::MaxDontcare = RasbSet.pattern_set().max_dontcare();
     unsigned FillSizeBegin = 0, FillSizeEnd = 0;
     if(MaxDontCare + Weight > 13){
         FillSizeBegin = (MaxDontCare+Weight-13)/2;
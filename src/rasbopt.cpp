@@ -29,8 +29,14 @@
 namespace rasb_opt{
     std::string OutFile = "rasbhari_set.pat";
     std::string InFile;
+    std::string Engine = "climb";
+    std::string Cooling = "geometric";
+    std::string HistFile;
+    std::string Objective = "oc";
+    std::string RescoreFile;
     double P = 0.75;
     double Q = 0.25;
+    double Temp = 0.5;
     long int Seed;
     unsigned Size = 10;
     unsigned Weight = 8;
@@ -39,12 +45,15 @@ namespace rasb_opt{
     unsigned H = 64;
     unsigned OptOc = 100;
     unsigned OptSens = 5000;
+    unsigned Threads = 0;
+    unsigned Elite = 0;
+    unsigned Reheat = 0;
+    unsigned Tenure = 100;
     unsigned MinDontcare = 10;
     unsigned MaxDontcare = 10;
     unsigned ImproveMode = 0;
     bool Improve = false;
     bool Forcesens = false;
-    bool Oc = true;
     bool Quiet = true;
     bool Sens = false;
     bool SetSeed = false;
@@ -90,4 +99,35 @@ namespace rasb_opt{
             MaxDontcare = std::atoi(Str);
         }
     }
-}
\ No newline at end of file
+    /**
+     * Selects the objective, that is optimised.
+     *
+     * @param Name      The name of a registered objective.
+     */
+    void set_objective(const std::string & Name){
+        Objective = Name;
+    }
+
+    /**
+     * The empty-constructor of a configuration; takes the current global
+     * options.
+     */
+    config::config():Engine(rasb_opt::Engine),Cooling(rasb_opt::Cooling),Objective(rasb_opt::Objective),P(rasb_opt::P),
+        Q(rasb_opt::Q),Temp(rasb_opt::Temp),Seed(rasb_opt::Seed),Size(rasb_opt::Size),Weight(rasb_opt::Weight),
+        MinDontcare(rasb_opt::MinDontcare),MaxDontcare(rasb_opt::MaxDontcare),SeqLength(rasb_opt::SeqLength),
+        Limit(rasb_opt::Limit),H(rasb_opt::H),OptOc(rasb_opt::OptOc),
+        OptSens(rasb_opt::OptSens),Threads(rasb_opt::Threads),Elite(rasb_opt::Elite),
+        Reheat(rasb_opt::Reheat),Tenure(rasb_opt::Tenure),
+        ImproveMode(rasb_opt::ImproveMode),Forcesens(rasb_opt::Forcesens),Quiet(rasb_opt::Quiet),Sens(rasb_opt::Sens),SetSeed(rasb_opt::SetSeed),
+        Silent(rasb_opt::Silent){
+    }
+    /**
+     * The default-constructor of a run state; starts with the values of the
+     * configuration.
+     *
+     * @param Config    The configuration of the run.
+     */
+    run_state::run_state(const config & Config):ImproveMode(Config.ImproveMode),OptSens(Config.OptSens),
+        Sens(Config.Sens),Forcesens(Config.Forcesens),SensPrinted(false){
+    }
+}
@@ -33,8 +33,14 @@
 namespace rasb_opt{
     extern std::string OutFile;
     extern std::string InFile;
+    extern std::string Engine;
+    extern std::string Cooling;
+    extern std::string HistFile;
+    extern std::string Objective;
+    extern std::string RescoreFile;
     extern double P;
     extern double Q;
+    extern double Temp;
     extern long int Seed;
     extern unsigned Size;
     extern unsigned Weight;
@@ -45,15 +51,73 @@ namespace rasb_opt{
     extern unsigned H;
     extern unsigned OptOc;
     extern unsigned OptSens;
+    extern unsigned Threads;
+    extern unsigned Elite;
+    extern unsigned Reheat;
+    extern unsigned Tenure;
     extern unsigned ImproveMode;
     extern bool Improve;
     extern bool Forcesens;
-    extern bool Oc; 
     extern bool Quiet;
     extern bool Sens;
     extern bool SetSeed;
     extern bool Silent;
 
     void parse_length(const char* Str);
+    void set_objective(const std::string & Name);
+
+    /**
+     * The configuration of one optimising run. The empty-constructor takes
+     * the current values of the global options, which are only set by the
+     * command line; a rasbhari instance keeps its own copy, such that
+     * several runs with different configurations can be done at once.
+     * ImproveMode, OptSens, Sens and Forcesens are the initial values of
+     * the run state.
+     */
+    struct config{
+        config();
+
+        std::string Engine;
+        std::string Cooling;
+        std::string Objective;
+        double P;
+        double Q;
+        double Temp;
+        long int Seed;
+        unsigned Size;
+        unsigned Weight;
+        unsigned MinDontcare;
+        unsigned MaxDontcare;
+        unsigned SeqLength;
+        unsigned Limit;
+        unsigned H;
+        unsigned OptOc;
+        unsigned OptSens;
+        unsigned Threads;
+        unsigned Elite;
+        unsigned Reheat;
+        unsigned Tenure;
+        unsigned ImproveMode;
+        bool Forcesens;
+        bool Quiet;
+        bool Sens;
+        bool SetSeed;
+        bool Silent;
+    };
+
+    /**
+     * The state of one optimising run, that changes while it runs: the
+     * improve mode selects the printed progress, the sensitivity switches
+     * are turned off, if the sensitivity can not be computed.
+     */
+    struct run_state{
+        run_state(const config & Config);
+
+        unsigned ImproveMode;
+        unsigned OptSens;
+        bool Sens;
+        bool Forcesens;
+        bool SensPrinted;
+    };
 };
 #endif
@@ -0,0 +1,191 @@
+/**
+ * This programm calculates the variance/OC and/or the sensitivity of a set of
+ * pattern with the same weight. It is possible to improve your patternset and
+ * read patterns from a file.
+ *
+ * random number stream object header file
+ *
+ * For theory please have a look at and also cite, if you have used rasbhari in your publications:
+ *
+ * - Hahn L, Leimeister C-A, Ounit R, Lonardi S, Morgenstern B (2016)
+ * rasbhari: Optimizing Spaced Seeds for Database Searching, Read Mapping and Alignment-Free Sequence Comparison.
+ * PLoS Comput Biol 12(10):e1005107. doi:10.1371/journal.pcbi.1005107
+ *
+ * - B. Morgenstern, B. Zhu, S. Horwege, C.-A Leimeister (2015)
+ * Estimating evolutionary distances between genomic sequences from spaced-word matches
+ * Algorithms for Molecular Biology 10, 5. (http://www.almob.org/content/10/1/5/abstract)
+ *
+ *
+ * @author: Lars Hahn - 23.08.2017, Georg-August-Universitaet Goettingen
+ */
+#ifndef RNG_HPP_
+#define RNG_HPP_
+
+#include <cstdint>
+#include <random>
+
+/**
+ * An object/instance of the rng class is a stream of random numbers, created
+ * by the xoshiro256** generator. The state has four words and is seeded by
+ * splitmix64, so a stream is cheap to create and to copy; numbers are
+ * generated in batches, which are handed out one by one.
+ *
+ * A stream can be passed to the standard distributions; below() draws an
+ * integer from a range without a distribution object. jump() advances the
+ * stream by 2^128 numbers, such that streams of different threads, created
+ * from the same seed, do not overlap.
+ */
+class rng{
+    public:
+        typedef uint64_t result_type;
+
+        rng();
+        rng(uint64_t Seed);
+
+        void seed(uint64_t Seed);
+        uint64_t operator()();
+        unsigned below(unsigned Bound);
+        void jump();
+
+        static constexpr uint64_t min(){ return 0; }
+        static constexpr uint64_t max(){ return UINT64_MAX; }
+        static rng & thread_stream();
+
+    private:
+        static const unsigned Batch = 16;
+        static uint64_t _rotl(uint64_t X, unsigned K);
+        uint64_t _next();
+        void _refill();
+
+        uint64_t _State[4];
+        uint64_t _Batch[Batch];
+        unsigned _Pos;
+};
+
+/**
+ * The empty-constructor; the stream is seeded from the random device.
+ */
+inline rng::rng(){
+    std::random_device RandomBit;
+    seed(((uint64_t)RandomBit() << 32) | RandomBit());
+}
+/**
+ * The seed-constructor; streams created from the same seed return the same
+ * numbers, which is used for reproducible runs.
+ *
+ * @param Seed          The seed of the stream.
+ */
+inline rng::rng(uint64_t Seed){
+    seed(Seed);
+}
+
+/**
+ * Seeds the stream; the four state words are created from the seed by
+ * splitmix64, so they are never all zero.
+ *
+ * @param Seed          The seed of the stream.
+ */
+inline void rng::seed(uint64_t Seed){
+    for(unsigned i = 0; i < 4; i++){
+        uint64_t Z = (Seed += 0x9e3779b97f4a7c15ULL);
+        Z = (Z ^ (Z >> 30))*0xbf58476d1ce4e5b9ULL;
+        Z = (Z ^ (Z >> 27))*0x94d049bb133111ebULL;
+        _State[i] = Z ^ (Z >> 31);
+    }
+    _Pos = Batch;
+}
+/**
+ * Returns the next random number of the stream; a new batch is generated,
+ * if the current one is used up.
+ *
+ * @return              A uniformly distributed 64 bit number.
+ */
+inline uint64_t rng::operator()(){
+    if(_Pos == Batch){
+        _refill();
+    }
+    return _Batch[_Pos++];
+}
+/**
+ * Returns a uniformly distributed number in [0,Bound), using a multiplication
+ * instead of a division; the rare biased values are rejected.
+ *
+ * @param Bound         The exclusive upper bound; has to be greater than 0.
+ *
+ * @return              A number in [0,Bound).
+ */
+inline unsigned rng::below(unsigned Bound){
+    uint64_t Product = ((*this)() >> 32)*Bound;
+    uint32_t Low = (uint32_t)Product;
+    if(Low < Bound){
+        uint32_t Threshold = (uint32_t)(-Bound) % Bound;
+        while(Low < Threshold){
+            Product = ((*this)() >> 32)*Bound;
+            Low = (uint32_t)Product;
+        }
+    }
+    return Product >> 32;
+}
+/**
+ * Advances the stream by 2^128 numbers; the numbers of the current batch are
+ * dropped.
+ */
+inline void rng::jump(){
+    static const uint64_t Jump[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+    uint64_t State[4] = {0, 0, 0, 0};
+    for(unsigned i = 0; i < 4; i++){
+        for(unsigned b = 0; b < 64; b++){
+            if(Jump[i] & ((uint64_t)1 << b)){
+                for(unsigned k = 0; k < 4; k++){
+                    State[k] ^= _State[k];
+                }
+            }
+            _next();
+        }
+    }
+    for(unsigned k = 0; k < 4; k++){
+        _State[k] = State[k];
+    }
+    _Pos = Batch;
+}
+/**
+ * Returns the stream of the calling thread, used if no stream is passed; it
+ * is seeded from the random device once per thread.
+ *
+ * @return              The stream of this thread.
+ */
+inline rng & rng::thread_stream(){
+    static thread_local rng Stream;
+    return Stream;
+}
+
+inline uint64_t rng::_rotl(uint64_t X, unsigned K){
+    return (X << K) | (X >> (64 - K));
+}
+/**
+ * One step of xoshiro256**.
+ *
+ * @return              The next number of the generator.
+ */
+inline uint64_t rng::_next(){
+    uint64_t Result = _rotl(_State[1]*5, 7)*9;
+    uint64_t T = _State[1] << 17;
+    _State[2] ^= _State[0];
+    _State[3] ^= _State[1];
+    _State[1] ^= _State[2];
+    _State[0] ^= _State[3];
+    _State[2] ^= T;
+    _State[3] = _rotl(_State[3], 45);
+    return Result;
+}
+/**
+ * Generates a new batch of numbers in one loop.
+ */
+inline void rng::_refill(){
+    for(unsigned i = 0; i < Batch; i++){
+        _Batch[i] = _next();
+    }
+    _Pos = 0;
+}
+#endif
@@ -20,19 +20,20 @@
  */
 #include "sensmem.hpp"
 
-double sensitivity_memory::MemVal = 0;
-
 /**
  * A function, which organizes the checking of the memory usage and interacts
  * with the user, if a lot of memory is currently used.
  * 
+ * @param State     The state of the run; the sensitivity is forced, if the
+ *                      user wants to continue.
+ *
  * @return  Possible user decision, if the calculation has to be stop or not.
  */
-bool sensitivity_memory::check_memory(){
+bool sensitivity_memory::check_memory(rasb_opt::run_state & State){
     std::string Input;
     uint32_t Stry;
     bool Answer, InputErr;
-    MemVal = available_memory();
+    double MemVal = available_memory();
     Answer = false;
     Stry = 0;
     InputErr = false;
@@ -45,7 +46,7 @@ bool sensitivity_memory::check_memory(){
             switch(Input[0]){
                 case 'Y':
                 case 'y':
-                    rasb_opt::Forcesens = true;
+                    State.Forcesens = true;
                     Stry = 4;
                     Answer = false;
                     break;
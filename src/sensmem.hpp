@@ -33,10 +33,9 @@
  * If there is not enough memory, a user interaction is started once.
  */
 namespace sensitivity_memory{
-    bool check_memory();
+    bool check_memory(rasb_opt::run_state & State);
     double available_memory();
     void security_message(std::string errmsg);
-    extern double MemVal;
 };
 
 #endif
\ No newline at end of file
@@ -50,8 +50,9 @@ inline long long speedsens::BIN_REVERSED_TO_INT2(char *s)     // converts the re
 /**
 * Computing sensitivity of a set of SEEDS with the given parameters
 * using the dynamic programming of (Li et al., 2004)
+* The memory checks turn off the sensitivity of the passed run state.
 */
-double speedsens::MULTIPLE_SENSITIVITY2(char** SEEDS, int NO_SEEDS, long long N, double P)
+double speedsens::MULTIPLE_SENSITIVITY2(char** SEEDS, int NO_SEEDS, long long N, double P, rasb_opt::run_state & State)
 {
     long long i = 0, j = 0, b = 0, pos = 0, MAX_L = 0, level = 0, prev_level_start = 0, prev_level_end = 0, compatible = 0,
         hit = 0, suffix_link = 0, zero_link = 0, new_i = 0, tmp = 0;
@@ -59,13 +60,12 @@ double speedsens::MULTIPLE_SENSITIVITY2(char** SEEDS, int NO_SEEDS, long long N,
     double f0 = 0, f1 = 0;
     // compute the lengths of the seeds and MAX_L = the length of the longest seed
 
-    if(!rasb_opt::Forcesens){   //Added by L.Hahn for memory/swap observation...
-        bool stop = sensitivity_memory::check_memory();
+    if(!State.Forcesens){   //Added by L.Hahn for memory/swap observation...
+        bool stop = sensitivity_memory::check_memory(State);
         if(stop){
-            rasb_opt::Sens = false;
-            rasb_opt::OptSens = 1;
-            rasb_opt::Forcesens = false;
-            sensitivity_memory::MemVal = 1;
+            State.Sens = false;
+            State.OptSens = 1;
+            State.Forcesens = false;
         }
     }                           // ... until here
     long long* seed_length = new long long[NO_SEEDS];
@@ -75,13 +75,12 @@ double speedsens::MULTIPLE_SENSITIVITY2(char** SEEDS, int NO_SEEDS, long long N,
         if (MAX_L < seed_length[i]) MAX_L = seed_length[i];
     }
     // compute the integer values of the reversed seeds INTeger REVersed SEEDS
-    if(!rasb_opt::Forcesens){   //Added by L.Hahn for memory/swap observation...
-        bool stop = sensitivity_memory::check_memory();
+    if(!State.Forcesens){   //Added by L.Hahn for memory/swap observation...
+        bool stop = sensitivity_memory::check_memory(State);
         if(stop){
-            rasb_opt::Sens = false;
-            rasb_opt::OptSens = 1;
-            rasb_opt::Forcesens = false;
-            sensitivity_memory::MemVal = 1;
+            State.Sens = false;
+            State.OptSens = 1;
+            State.Forcesens = false;
             delete[] seed_length;
             return -1;
         }
@@ -111,13 +110,12 @@ double speedsens::MULTIPLE_SENSITIVITY2(char** SEEDS, int NO_SEEDS, long long N,
     long long NO_BS = MAX_NO_BS;
     //cout << NO_BS << endl;
     //bound for computing sensitivity (not allocate more than 120GB)
-    if(!rasb_opt::Forcesens){   //Added by L.Hahn for memory/swap observation...
-        bool stop = sensitivity_memory::check_memory();
+    if(!State.Forcesens){   //Added by L.Hahn for memory/swap observation...
+        bool stop = sensitivity_memory::check_memory(State);
         if(stop){
-            rasb_opt::Sens = false;
-            rasb_opt::OptSens = 1;
-            rasb_opt::Forcesens = false;
-            sensitivity_memory::MemVal = 1;
+            State.Sens = false;
+            State.OptSens = 1;
+            State.Forcesens = false;
             delete[] seed_length; delete[] INT_REV_SEEDS;
             return -1;
         }
@@ -125,13 +123,12 @@ double speedsens::MULTIPLE_SENSITIVITY2(char** SEEDS, int NO_SEEDS, long long N,
     long long **BS = new long long *[NO_BS];
 
     for (i = 0; i <= NO_BS - 1; i++) {
-        if(!rasb_opt::Forcesens){//Added by L.Hahn for memory/swap observation...
-            bool stop = sensitivity_memory::check_memory();
+        if(!State.Forcesens){//Added by L.Hahn for memory/swap observation...
+            bool stop = sensitivity_memory::check_memory(State);
             if(stop){   
-                rasb_opt::Sens = false;
-                rasb_opt::OptSens = 1;
-                rasb_opt::Forcesens = false;
-                sensitivity_memory::MemVal = 1;
+                State.Sens = false;
+                State.OptSens = 1;
+                State.Forcesens = false;
                 delete[] seed_length; delete[] INT_REV_SEEDS;
                 for (i = 0; i <= MAX_NO_BS - 1; i++)
                     delete[] BS[i];
@@ -230,13 +227,12 @@ double speedsens::MULTIPLE_SENSITIVITY2(char** SEEDS, int NO_SEEDS, long long N,
         }
         // compute the f's  f[i][j] = probab to hit a prefix of length i that ends with INT_TO_BIN_REVERSED[BS[j][0]]
         double **f;
-        if(!rasb_opt::Forcesens){//Added by L.Hahn for memory/swap observation...
-            bool stop = sensitivity_memory::check_memory();
+        if(!State.Forcesens){//Added by L.Hahn for memory/swap observation...
+            bool stop = sensitivity_memory::check_memory(State);
             if(stop){
-                rasb_opt::Sens = false;
-                rasb_opt::OptSens = 1;
-                rasb_opt::Forcesens = false;
-                sensitivity_memory::MemVal = 1;
+                State.Sens = false;
+                State.OptSens = 1;
+                State.Forcesens = false;
                 delete[] seed_length; delete[] INT_REV_SEEDS;
                 for (i = 0; i <= MAX_NO_BS - 1; i++)
                     delete[] BS[i];
@@ -248,13 +244,12 @@ double speedsens::MULTIPLE_SENSITIVITY2(char** SEEDS, int NO_SEEDS, long long N,
         f = new double*[N + 1];
     
         for (i = 0; i <= N; i++) {
-            if(!rasb_opt::Forcesens){//Added by L.Hahn for memory/swap observation...
-                bool stop = sensitivity_memory::check_memory();
+            if(!State.Forcesens){//Added by L.Hahn for memory/swap observation...
+                bool stop = sensitivity_memory::check_memory(State);
                 if(stop){
-                    rasb_opt::Sens = false;
-                    rasb_opt::OptSens = 1;
-                    rasb_opt::Forcesens = false;
-                    sensitivity_memory::MemVal = 1;
+                    State.Sens = false;
+                    State.OptSens = 1;
+                    State.Forcesens = false;
                     delete[] seed_length; delete[] INT_REV_SEEDS;
                     for (i = 0; i <= N; i++)
                         delete[] f[i];
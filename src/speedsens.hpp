@@ -34,6 +34,6 @@
  */
 namespace speedsens{
     inline long long BIN_REVERSED_TO_INT2(char *s);
-    double MULTIPLE_SENSITIVITY2(char** SEEDS, int NO_SEEDS, long long N, double P);
+    double MULTIPLE_SENSITIVITY2(char** SEEDS, int NO_SEEDS, long long N, double P, rasb_opt::run_state & State);
 };
 #endif
\ No newline at end of file